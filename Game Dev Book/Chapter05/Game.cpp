@@ -6,6 +6,7 @@
 #include "Texture.hpp"
 #include "Asteroid.hpp"
 #include "Ship.hpp"
+#include "TimerWheel.hpp"
 #include <algorithm>
 
 Game::Game() {
@@ -13,6 +14,7 @@ Game::Game() {
     mIsRunning = true;
     mUpdatingActors = false;
     mTicksCount = 0;
+    mTimers = new TimerWheel();
 
     Vector3* red = new Vector3(1.0f, 0.0f, 0.0f);
     Vector3* blue = new Vector3(0.0f, 0.0f, 1.0f);
@@ -107,6 +109,9 @@ void Game::RunLoop() {
 
 void Game::ShutDown() {
     UnloadData();
+    // actors cancel their own timers, so this goes after them
+    delete mTimers;
+    mTimers = nullptr;
     delete mSpriteVerts;
     mSpriteShader->Unload();
     delete mSpriteShader;
@@ -331,6 +336,9 @@ void Game::UpdateGame() {
 
     mTicksCount = SDL_GetTicks();
 
+    // fire any timers that came due (lifetimes, cooldowns)
+    mTimers->Advance(deltaTime);
+
     // update all actors
     mUpdatingActors = true;
     for (auto actor : mActors) {
@@ -28,6 +28,11 @@ public:
     void RemoveAsteroid(class Asteroid* ast);
     std::vector<class Asteroid*> GetAsteroids();
 
+    // gameplay timers (advanced once per frame, before actors update)
+    class TimerWheel* GetTimers() {
+        return mTimers;
+    }
+
 private:
     void ProcessInput();
     void UpdateGame();
@@ -56,6 +61,8 @@ private:
     // track if we are updating actors right now
     bool mUpdatingActors;
 
+    class TimerWheel* mTimers;
+
     // map of textures loaded
     //std::unordered_map<std::string, SDL_Texture*> mTextureMap;
     std::unordered_map<std::string, class Texture*> mTextureMap;
@@ -5,6 +5,7 @@
 #include "CircleComponent.hpp"
 #include "Texture.hpp"
 #include "Asteroid.hpp"
+#include "TimerWheel.hpp"
 
 Laser::Laser(Game* game, float rotation) : Actor(game) {
 	// create a sprite component
@@ -22,18 +23,17 @@ Laser::Laser(Game* game, float rotation) : Actor(game) {
 	mc->SetAngularSpeed(0.0f);
 	mc->SetForwardSpeed(800.0f);
 	
-	mAliveTime = 1.0f;
-}
-
-void Laser::UpdateActor(float deltaTime) {
 	// if we run out of time, laser is dead
-	mAliveTime -= deltaTime;
-	if (mAliveTime <= 0.0f) {
-		// remove this laser
+	mAliveTimer = game->GetTimers()->Schedule(1.0f, [this]() {
 		SetState(EDead);
-		return;
-	}
+	});
+}
+
+Laser::~Laser() {
+	GetGame()->GetTimers()->Cancel(mAliveTimer);
+}
 
+void Laser::UpdateActor(float /*deltaTime*/) {
 	// test for intersection against asteroids
 	// do we intersect with an asteroid?
 	for (auto ast : GetGame()->GetAsteroids()) {
@@ -6,6 +6,7 @@
 #include "Asteroid.hpp"
 #include "Texture.hpp"
 #include "Laser.hpp"
+#include "TimerWheel.hpp"
 
 Ship::Ship(Game* game) : Actor(game) {
 	// create a sprite component
@@ -25,20 +26,23 @@ Ship::Ship(Game* game) : Actor(game) {
 	mCircleComp = new CircleComponent(this);
 	mCircleComp->SetRadius(40.0f);
 
-	mLaserCooldown = 0.0f;
+	mCanFire = true;
+}
+
+Ship::~Ship() {
+	GetGame()->GetTimers()->Cancel(mLaserCooldown);
 }
 
 void Ship::ActorInput(const uint8_t* keyState) {
-	if (keyState[SDL_SCANCODE_SPACE] && mLaserCooldown <= 0.0f && !mDead) {
+	if (keyState[SDL_SCANCODE_SPACE] && mCanFire && !mDead) {
 		// create a laser and set its position/rotation to mine
 		Laser* laser = new Laser(GetGame(), GetRotation());
 		laser->SetPosition(GetPosition());
 
-		// reset laser cooldown (half second)
-		mLaserCooldown = 0.5f;
+		// laser cooldown (half second)
+		mCanFire = false;
+		mLaserCooldown = GetGame()->GetTimers()->Schedule(0.5f, [this]() {
+			mCanFire = true;
+		});
 	}
 }
-
-void Ship::UpdateActor(float deltaTime) {
-	mLaserCooldown -= deltaTime;
-}
@@ -1,19 +1,22 @@
 #pragma once
 
 #include "Actor.hpp"
+#include "TimerWheel.hpp"
 
 class Ship : public Actor {
 public:
 	Ship(class Game* game);
+	~Ship();
 
 	void ActorInput(const uint8_t* keyState) override;
-	void UpdateActor(float deltaTime) override;
 
 	void OnDeath();
 	void OnRevive();
 
 private:
-	float mLaserCooldown;
+	// cleared while the laser cooldown timer runs
+	bool mCanFire;
+	TimerHandle mLaserCooldown;
 	float mResetTimer;
 	bool mDead;
 
@@ -0,0 +1,184 @@
+#include "TimerWheel.hpp"
+#include <cmath>
+
+const float TimerWheel::TickLength = 0.01f;
+
+TimerWheel::TimerWheel() {
+	for (auto& head : mSlots) {
+		head = Invalid;
+	}
+	for (auto& bits : mOccupied) {
+		bits = 0;
+	}
+	mCurrentTick = 0;
+	mRemainder = 0.0f;
+	mNumActive = 0;
+}
+
+TimerHandle TimerWheel::Schedule(float delay, const std::function<void()>& callback, float interval) {
+	uint32_t index = 0;
+	if (!mFreeTimers.empty()) {
+		index = mFreeTimers.back();
+		mFreeTimers.pop_back();
+	}
+	else {
+		index = static_cast<uint32_t>(mTimers.size());
+		Timer timer;
+		timer.mGeneration = 1;
+		timer.mSlot = Invalid;
+		mTimers.emplace_back(timer);
+	}
+
+	// round up, so a timer never fires early (and always at least one tick from now)
+	uint64_t delayTicks = static_cast<uint64_t>(std::ceil(delay / TickLength));
+	uint64_t intervalTicks = interval > 0.0f ? static_cast<uint64_t>(std::ceil(interval / TickLength)) : 0;
+
+	Timer& timer = mTimers[index];
+	timer.mCallback = callback;
+	timer.mExpiry = mCurrentTick + (delayTicks > 0 ? delayTicks : 1);
+	timer.mInterval = intervalTicks;
+	Insert(index);
+	mNumActive += 1;
+
+	return TimerHandle(index, timer.mGeneration);
+}
+
+bool TimerWheel::Cancel(TimerHandle handle) {
+	if (!IsActive(handle)) {
+		return false;
+	}
+
+	Unlink(handle.mIndex);
+	Release(handle.mIndex);
+	return true;
+}
+
+bool TimerWheel::IsActive(TimerHandle handle) const {
+	return handle.mIndex < mTimers.size() &&
+		mTimers[handle.mIndex].mGeneration == handle.mGeneration &&
+		mTimers[handle.mIndex].mSlot != Invalid;
+}
+
+void TimerWheel::Advance(float deltaTime) {
+	mRemainder += deltaTime;
+	uint64_t ticks = static_cast<uint64_t>(mRemainder / TickLength);
+	mRemainder -= ticks * TickLength;
+
+	for (uint64_t i = 0; i < ticks; ++i) {
+		// nothing scheduled, so there is nothing to cascade or fire either
+		if (mNumActive == 0) {
+			mCurrentTick += ticks - i;
+			break;
+		}
+		Tick();
+	}
+}
+
+void TimerWheel::Tick() {
+	mCurrentTick += 1;
+
+	// at the start of a slot of a higher level, its timers are close enough to move down
+	// (lowest level first, a timer coming down from higher up never lands in a slot already handled)
+	for (uint32_t level = 1; level < NumLevels; ++level) {
+		uint64_t lowerTicks = (1ull << (SlotBits * level)) - 1;
+		if ((mCurrentTick & lowerTicks) != 0) {
+			break;
+		}
+
+		uint32_t slot = static_cast<uint32_t>(mCurrentTick >> (SlotBits * level)) & (SlotsPerLevel - 1);
+		if ((mOccupied[level] & (1ull << slot)) == 0) {
+			continue;
+		}
+
+		uint32_t index = mSlots[level * SlotsPerLevel + slot];
+		mSlots[level * SlotsPerLevel + slot] = Invalid;
+		mOccupied[level] &= ~(1ull << slot);
+		while (index != Invalid) {
+			uint32_t next = mTimers[index].mNext;
+			Insert(index);
+			index = next;
+		}
+	}
+
+	// fire everything due this tick
+	uint32_t slot = static_cast<uint32_t>(mCurrentTick) & (SlotsPerLevel - 1);
+	if ((mOccupied[0] & (1ull << slot)) == 0) {
+		return;
+	}
+	// the callbacks may schedule/cancel timers, but never into this slot (it's at least a tick away)
+	while (mSlots[slot] != Invalid) {
+		uint32_t index = mSlots[slot];
+		Unlink(index);
+
+		// copy the callback out: it can schedule new timers, which may move mTimers
+		std::function<void()> callback = mTimers[index].mCallback;
+		if (mTimers[index].mInterval > 0) {
+			mTimers[index].mExpiry += mTimers[index].mInterval;
+			Insert(index);
+		}
+		else {
+			Release(index);
+		}
+
+		callback();
+	}
+}
+
+void TimerWheel::Insert(uint32_t index) {
+	Timer& timer = mTimers[index];
+
+	// level by distance from now (timers beyond the last level wait in its furthest slot and come back up)
+	uint64_t delta = timer.mExpiry > mCurrentTick ? timer.mExpiry - mCurrentTick : 0;
+	uint64_t tick = timer.mExpiry;
+	uint32_t level = 0;
+	while (level + 1 < NumLevels && delta >= (1ull << (SlotBits * (level + 1)))) {
+		level += 1;
+	}
+	if (delta >= (1ull << (SlotBits * NumLevels))) {
+		tick = mCurrentTick + (1ull << (SlotBits * NumLevels)) - 1;
+	}
+	uint32_t slot = static_cast<uint32_t>(tick >> (SlotBits * level)) & (SlotsPerLevel - 1);
+
+	// push on the front of the slot list
+	uint32_t& head = mSlots[level * SlotsPerLevel + slot];
+	timer.mPrev = Invalid;
+	timer.mNext = head;
+	if (head != Invalid) {
+		mTimers[head].mPrev = index;
+	}
+	head = index;
+	timer.mSlot = level * SlotsPerLevel + slot;
+	mOccupied[level] |= 1ull << slot;
+}
+
+void TimerWheel::Unlink(uint32_t index) {
+	Timer& timer = mTimers[index];
+	if (timer.mPrev != Invalid) {
+		mTimers[timer.mPrev].mNext = timer.mNext;
+	}
+	else {
+		mSlots[timer.mSlot] = timer.mNext;
+	}
+	if (timer.mNext != Invalid) {
+		mTimers[timer.mNext].mPrev = timer.mPrev;
+	}
+
+	// slot is empty now
+	if (mSlots[timer.mSlot] == Invalid) {
+		mOccupied[timer.mSlot / SlotsPerLevel] &= ~(1ull << (timer.mSlot % SlotsPerLevel));
+	}
+	timer.mSlot = Invalid;
+}
+
+void TimerWheel::Release(uint32_t index) {
+	Timer& timer = mTimers[index];
+	timer.mCallback = nullptr;
+	timer.mSlot = Invalid;
+	// old handles no longer match (skip 0, which is the "no timer" generation)
+	timer.mGeneration += 1;
+	if (timer.mGeneration == 0) {
+		timer.mGeneration = 1;
+	}
+	mFreeTimers.emplace_back(index);
+	mNumActive -= 1;
+}
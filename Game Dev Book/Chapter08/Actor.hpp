@@ -5,8 +5,12 @@
 #include "Component.hpp"
 #include "InputSystem.hpp"
 #include <cstdint>
+#include "PoolAllocator.hpp"
 
 class Actor {
+	// actors/components of every type come from the size-class pools
+	DECLARE_POOL_ALLOCATED()
+
 public:
 	// used to track state of actor
 	enum State {
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <cstdint>
+#include "PoolAllocator.hpp"
 #include "InputSystem.hpp"
 
 class Component {
+	// actors/components of every type come from the size-class pools
+	DECLARE_POOL_ALLOCATED()
+
 public:
 	// constructor
 	// (the lower the update order, the earlier the component updates)
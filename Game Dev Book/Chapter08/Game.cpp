@@ -1,5 +1,7 @@
 #include "Game.hpp"
 #include "Actor.hpp"
+#include "PoolAllocator.hpp"
+#include "TimerWheel.hpp"
 #include <algorithm>
 #include <GL/glew.h>
 #include "Shader.hpp"
@@ -10,7 +12,7 @@
 #include <string>
 #include "MoveComponent.hpp"
 #include "SpriteComponent.hpp"
-#include "VertexArray.hpp"
+#include "SpriteBatch.hpp"
 #include "Ship.hpp"
 #include "Asteroid.hpp"
 
@@ -18,9 +20,11 @@ Game::Game() {
     mIsRunning = true;
     mUpdatingActors = false;
     mTicksCount = 0;
+    mTimers = new TimerWheel();
 
     mWindow = nullptr;
     mSpriteShader = nullptr;
+    mSpriteBatch = nullptr;
 }
 
 bool Game::Initialize() {
@@ -80,8 +84,8 @@ bool Game::Initialize() {
         return false;
     }
 
-    // create quad for drawing sprites
-    CreateSpriteVerts();
+    // create the batch for drawing sprites
+    mSpriteBatch = new SpriteBatch();
 
     LoadData();
 
@@ -100,13 +104,17 @@ void Game::RunLoop() {
 
 void Game::ShutDown() {
     UnloadData();
+    // actors cancel their own timers, so this goes after them
+    delete mTimers;
+    mTimers = nullptr;
+    PoolAllocator::LogStats();
     
     if (mInputSystem) {
         mInputSystem->Shutdown();
         delete mInputSystem;
     }
 
-    delete mSpriteVerts;
+    delete mSpriteBatch;
     mSpriteShader->Unload();
     delete mSpriteShader;
     
@@ -247,6 +255,9 @@ void Game::UpdateGame() {
 
     mTicksCount = SDL_GetTicks();
 
+    // fire any timers that came due (lifetimes, cooldowns)
+    mTimers->Advance(deltaTime);
+
     // update all actors
     mUpdatingActors = true;
     for (auto actor : mActors) {
@@ -288,12 +299,13 @@ void Game::GenerateOutput() {
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    // set shader/vao as active
+    // set shader as active, then collect every sprite (in draw order) and draw them in as few calls as possible
     mSpriteShader->SetActive();
-    mSpriteVerts->SetActive();
+    mSpriteBatch->Begin();
     for (auto sprite : mSprites) {
-        sprite->Draw(mSpriteShader);
+        sprite->Draw(mSpriteBatch);
     }
+    mSpriteBatch->End();
 
     // swap the buffers
     SDL_GL_SwapWindow(mWindow);
@@ -301,7 +313,7 @@ void Game::GenerateOutput() {
 
 bool Game::LoadShaders() {
     mSpriteShader = new Shader();
-    if (!mSpriteShader->Load("Shaders/Sprite.vert", "Shaders/Sprite.frag")) {
+    if (!mSpriteShader->Load("Shaders/SpriteBatch.vert", "Shaders/Sprite.frag")) {
         return false;
     }
 
@@ -312,22 +324,6 @@ bool Game::LoadShaders() {
     return true;
 }
 
-void Game::CreateSpriteVerts() {
-    float vertices[] = {
-        -0.5f, 0.5f, 0.0f, 0.0f, 0.0f,
-        0.5f, 0.5f, 0.0f, 1.0f, 0.0f,
-        0.5f, -0.5f, 0.0, 1.0f, 1.0f,
-        -0.5f, -0.5f, 0.0f, 0.0f, 1.0f
-    };
-
-    unsigned int indices[] = {
-        0, 1, 2,
-        2, 3, 0
-    };
-
-    mSpriteVerts = new VertexArray(vertices, 4, indices, 6);
-}
-
 Texture* Game::GetTexture(const std::string& fileName) {
     Texture* tex = nullptr;
     auto iter = mTextures.find(fileName);
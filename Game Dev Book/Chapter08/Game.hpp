@@ -29,13 +29,17 @@ public:
         return mAsteroids;
     }
 
+    // gameplay timers (advanced once per frame, before actors update)
+    class TimerWheel* GetTimers() {
+        return mTimers;
+    }
+
 private:
     void ProcessInput();
     void UpdateGame();
     void GenerateOutput();
 
     bool LoadShaders();
-    void CreateSpriteVerts();
     
     void LoadData();
     void UnloadData();
@@ -47,6 +51,8 @@ private:
     // track if we are updating actors right now
     bool mUpdatingActors;
 
+    class TimerWheel* mTimers;
+
     class InputSystem* mInputSystem;
 
     // all the actors in the game
@@ -58,7 +64,8 @@ private:
     std::vector<class SpriteComponent*> mSprites;
 
     class Shader* mSpriteShader;
-    class VertexArray* mSpriteVerts;
+    // every sprite of a frame, drawn with a draw call per texture run
+    class SpriteBatch* mSpriteBatch;
 
     SDL_Window* mWindow;
     SDL_GLContext mContext;
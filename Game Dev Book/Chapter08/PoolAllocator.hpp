@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// size-class pool allocator for actors and components
+// - requests are rounded up to a multiple of Granularity bytes, and each size class keeps a free list
+//   of same-sized blocks carved out of big chunks
+// - freed blocks go back onto their size class's free list and are handed out again by the next
+//   allocation of that size, so spawning/killing lots of short-lived objects (bullets, enemies)
+//   doesn't touch the general-purpose heap after warm-up
+// - requests bigger than MaxPooledSize just use the global operator new
+// NOTE: not thread safe
+class PoolAllocator {
+public:
+	static void* Allocate(size_t size);
+	// size must be the size passed to Allocate (sized operator delete gets it right for virtual destructors)
+	static void Free(void* ptr, size_t size);
+
+	// recycling statistics for a single size class
+	struct Stats {
+		size_t mBlockSize;
+		uint64_t mAllocations;  // total allocations served
+		uint64_t mRecycled;  // allocations served from a previously freed block
+		uint64_t mFrees;
+		size_t mLive;  // blocks currently in use
+		size_t mPeakLive;
+		size_t mCapacity;  // blocks carved out of chunks so far
+	};
+
+	// stats for every size class that has been used
+	static std::vector<Stats> GetStats();
+	// print the stats with SDL_Log
+	static void LogStats();
+
+	static const size_t Granularity = 16;
+	static const size_t MaxPooledSize = 512;
+
+private:
+	// free blocks store the pointer to the next free block in their first bytes
+	struct FreeBlock {
+		FreeBlock* mNext;
+	};
+
+	struct SizeClass {
+		FreeBlock* mFreeList;
+		// every chunk allocated for this class (freed on shutdown)
+		std::vector<unsigned char*> mChunks;
+		Stats mStats;
+	};
+
+	static const size_t NumSizeClasses = MaxPooledSize / Granularity;
+	// each new chunk holds this many bytes' worth of blocks
+	static const size_t ChunkBytes = 64 * 1024;
+
+	PoolAllocator();
+	~PoolAllocator();
+
+	static PoolAllocator& Get();
+
+	// carve a new chunk into free blocks for a size class
+	void Grow(SizeClass& sizeClass);
+
+	SizeClass mClasses[NumSizeClasses];
+};
+
+// route a class's new/delete through the PoolAllocator (derived classes inherit it)
+#define DECLARE_POOL_ALLOCATED() \
+public: \
+	static void* operator new(size_t size) { \
+		return PoolAllocator::Allocate(size); \
+	} \
+	static void operator delete(void* ptr, size_t size) { \
+		PoolAllocator::Free(ptr, size); \
+	}
@@ -0,0 +1,20 @@
+/* request GLSL 3.3 */
+#version 330
+
+/* uniform for view-proj (there's no world transform, SpriteBatch already moved the vertices into world space) */
+uniform mat4 uViewProj;
+
+/* any vertex attributes go here */
+layout(location=0) in vec3 inPosition;  /* world space */
+layout(location=1) in vec2 inTexCoord;
+
+/* declare a global out variable to pass texture coord data from vertex shader to fragment shader */
+out vec2 fragTexCoord;
+
+void main() {
+    /* transform the position into clip space by multiplying it by the view-projection matrix */
+    gl_Position = vec4(inPosition, 1.0) * uViewProj;
+
+    /* copy tex coord directly from input to output variable, to pass along the texture coord to frag shader */
+    fragTexCoord = inTexCoord;
+}
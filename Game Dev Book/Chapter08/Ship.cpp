@@ -4,6 +4,7 @@
 #include "InputSystem.hpp"
 #include "Texture.hpp"
 #include "Laser.hpp"
+#include "TimerWheel.hpp"
 
 Ship::Ship(Game* game, int controllerIndex) : Actor(game) {
 	// create a sprite component
@@ -11,24 +12,31 @@ Ship::Ship(Game* game, int controllerIndex) : Actor(game) {
 	sc->SetTexture(game->GetTexture("Assets/Ship.png"));
 	
 	mSpeed = 400.0f;
-	mLaserCooldown = 0.0f;
+	mCanFire = true;
 	mControllerIndex = controllerIndex;
 }
 
+Ship::~Ship() {
+	GetGame()->GetTimers()->Cancel(mLaserCooldown);
+}
+
 void Ship::ActorInput(const InputState& state) {
 	for (int i = 0; i < state.Controllers.size(); ++i) {
 		ControllerState controllerState = state.Controllers[i];
 		if (controllerState.GetControllerIndex() == mControllerIndex && controllerState.GetIsConnected()) {
 			// found the controller state
 			if (controllerState.GetRightTrigger() > 0.25f &&
-				mLaserCooldown <= 0.0f) {
+				mCanFire) {
 				// create a laser and set its position/rotation to mine
 				Laser* laser = new Laser(GetGame());
 				laser->SetPosition(GetPosition());
 				laser->SetRotation(GetRotation());
 
-				// reset laser cooldown 
-				mLaserCooldown = 0.25f;
+				// laser cooldown
+				mCanFire = false;
+				mLaserCooldown = GetGame()->GetTimers()->Schedule(0.25f, [this]() {
+					mCanFire = true;
+				});
 			}
 
 			mVelocityDir = controllerState.GetLeftStick();
@@ -42,8 +50,6 @@ void Ship::ActorInput(const InputState& state) {
 }
 
 void Ship::UpdateActor(float deltaTime) {
-	mLaserCooldown -= deltaTime;
-
 	// update position based on velocity
 	Vector2 pos = GetPosition();
 	pos += mVelocityDir * mSpeed * deltaTime;
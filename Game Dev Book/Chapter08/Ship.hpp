@@ -1,10 +1,12 @@
 #pragma once
 
 #include "Actor.hpp"
+#include "TimerWheel.hpp"
 
 class Ship : public Actor {
 public:
 	Ship(class Game* game, int controllerIndex);
+	~Ship();
 
 	void ActorInput(const struct InputState& state) override;
 	void UpdateActor(float deltaTime) override;
@@ -17,6 +19,8 @@ private:
 	Vector2 mVelocityDir;
 	Vector2 mRotationDir;
 	float mSpeed;
-	float mLaserCooldown;
+	// cleared while the laser cooldown timer runs
+	bool mCanFire;
+	TimerHandle mLaserCooldown;
 	int mControllerIndex;
 };
\ No newline at end of file
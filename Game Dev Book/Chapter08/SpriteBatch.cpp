@@ -0,0 +1,136 @@
+#include "SpriteBatch.hpp"
+#include <GL/glew.h>
+#include <xmmintrin.h>
+#include "Texture.hpp"
+
+namespace {
+	const unsigned int FloatsPerVertex = 5;
+	const unsigned int FloatsPerQuad = FloatsPerVertex * 4;
+}
+
+SpriteBatch::SpriteBatch() {
+	mNumQuads = 0;
+	mIndexCapacity = 0;
+	mVertexCapacity = 0;
+
+	// create the vertex array object, with buffers that get their storage on first use
+	glGenVertexArrays(1, &mVertexArray);
+	glBindVertexArray(mVertexArray);
+	glGenBuffers(1, &mVertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+	glGenBuffers(1, &mIndexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+
+	// same vertex layout as the sprite quad: position (attribute 0) and texture coord (attribute 1)
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(float) * FloatsPerVertex, 0);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(float) * FloatsPerVertex,
+		reinterpret_cast<void*>(sizeof(float) * 3));
+}
+
+SpriteBatch::~SpriteBatch() {
+	glDeleteBuffers(1, &mVertexBuffer);
+	glDeleteBuffers(1, &mIndexBuffer);
+	glDeleteVertexArrays(1, &mVertexArray);
+}
+
+void SpriteBatch::Begin() {
+	// keeps the capacity, so a steady number of sprites doesn't allocate
+	mVertices.clear();
+	mRuns.clear();
+	mNumQuads = 0;
+}
+
+void SpriteBatch::Draw(Texture* texture, const Matrix4& world) {
+	// a new texture starts a new run
+	if (mRuns.empty() || mRuns.back().mTexture != texture) {
+		mRuns.push_back({texture, mNumQuads, 0});
+	}
+	mRuns.back().mNumQuads += 1;
+
+	// the quad is the unit square (corners at +-0.5) scaled to the texture size, so with row vectors
+	// a corner (x, y, 0, 1) ends up at x * width * row0 + y * height * row1 + row3 of world
+	__m128 halfX = _mm_mul_ps(_mm_loadu_ps(world.mat[0]), _mm_set1_ps(0.5f * texture->GetWidth()));
+	__m128 halfY = _mm_mul_ps(_mm_loadu_ps(world.mat[1]), _mm_set1_ps(0.5f * texture->GetHeight()));
+	__m128 center = _mm_loadu_ps(world.mat[3]);
+
+	__m128 top = _mm_add_ps(center, halfY);
+	__m128 bottom = _mm_sub_ps(center, halfY);
+	__m128 corners[4] = {
+		_mm_sub_ps(top, halfX),  // top left
+		_mm_add_ps(top, halfX),  // top right
+		_mm_add_ps(bottom, halfX),  // bottom right
+		_mm_sub_ps(bottom, halfX)  // bottom left
+	};
+	const float texCoords[4][2] = {
+		{0.0f, 0.0f},
+		{1.0f, 0.0f},
+		{1.0f, 1.0f},
+		{0.0f, 1.0f}
+	};
+
+	size_t first = mVertices.size();
+	mVertices.resize(first + FloatsPerQuad);
+	float* vertex = mVertices.data() + first;
+	for (int i = 0; i < 4; ++i) {
+		// x, y, z (and w, which the texture coord then overwrites)
+		_mm_storeu_ps(vertex, corners[i]);
+		vertex[3] = texCoords[i][0];
+		vertex[4] = texCoords[i][1];
+		vertex += FloatsPerVertex;
+	}
+	mNumQuads += 1;
+}
+
+void SpriteBatch::End() {
+	if (mNumQuads == 0) {
+		return;
+	}
+
+	glBindVertexArray(mVertexArray);
+	ReserveIndices(mNumQuads);
+
+	// all the quads of the frame in one upload
+	// (a fresh buffer each frame, so the driver doesn't wait for last frame's draws to finish with it)
+	size_t size = mVertices.size() * sizeof(float);
+	if (size > mVertexCapacity) {
+		mVertexCapacity = size * 2;
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, mVertexCapacity, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, mVertices.data());
+
+	for (const Run& run : mRuns) {
+		run.mTexture->SetActive();
+		glDrawElements(
+			GL_TRIANGLES,
+			run.mNumQuads * 6,  // 6 indices per quad
+			GL_UNSIGNED_INT,
+			reinterpret_cast<void*>(sizeof(unsigned int) * 6 * run.mFirstQuad)  // offset of the run's first index
+		);
+	}
+}
+
+void SpriteBatch::ReserveIndices(unsigned int numQuads) {
+	if (numQuads <= mIndexCapacity) {
+		return;
+	}
+
+	// the indices never change, only how many of them are used
+	mIndexCapacity = numQuads * 2;
+	std::vector<unsigned int> indices(mIndexCapacity * 6);
+	for (unsigned int quad = 0; quad < mIndexCapacity; ++quad) {
+		unsigned int vertex = quad * 4;
+		unsigned int* index = &indices[quad * 6];
+		index[0] = vertex;
+		index[1] = vertex + 1;
+		index[2] = vertex + 2;
+		index[3] = vertex + 2;
+		index[4] = vertex + 3;
+		index[5] = vertex;
+	}
+	// the element buffer binding is part of the vertex array, which is active here
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include "Math.hpp"
+
+// draws many sprites with few draw calls
+// - each sprite's quad is transformed on the CPU (SSE, 4 corners at once) and appended to one vertex array
+// - consecutive sprites with the same texture form a run; End uploads every quad of the frame in one
+//   buffer write and issues one draw per run
+// - sprites must be added in draw order (the runs are drawn in the order they were added)
+// - vertices are already in world space, so the shader only needs uViewProj (see Shaders/SpriteBatch.vert)
+class SpriteBatch {
+public:
+	SpriteBatch();
+	~SpriteBatch();
+
+	// start a new frame of sprites
+	void Begin();
+	// add a texture-sized quad, transformed by world (the owner's world transform)
+	void Draw(class Texture* texture, const Matrix4& world);
+	// upload the quads and draw the runs (the sprite shader must be active)
+	void End();
+
+private:
+	// one draw call worth of quads
+	struct Run {
+		class Texture* mTexture;
+		unsigned int mFirstQuad;
+		unsigned int mNumQuads;
+	};
+
+	// make the index buffer hold at least numQuads quads
+	void ReserveIndices(unsigned int numQuads);
+
+	// x, y, z, u, v per vertex, 4 vertices per quad
+	std::vector<float> mVertices;
+	std::vector<Run> mRuns;
+	unsigned int mNumQuads;
+
+	// OpenGL IDs of the vertex array object and its buffers
+	unsigned int mVertexArray;
+	unsigned int mVertexBuffer;
+	unsigned int mIndexBuffer;
+	// quads the index buffer has indices for
+	unsigned int mIndexCapacity;
+	// bytes of storage in the vertex buffer
+	size_t mVertexCapacity;
+};
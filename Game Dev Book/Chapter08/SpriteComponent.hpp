@@ -9,7 +9,8 @@ public:
 	SpriteComponent(class Actor* owner, int drawOrder = 100);
 	~SpriteComponent();
 
-	virtual void Draw(class Shader* shader);
+	// add this sprite to the frame's batch
+	virtual void Draw(class SpriteBatch* batch);
 	virtual void SetTexture(class Texture* texture);
 
 	int GetDrawOrder() const {
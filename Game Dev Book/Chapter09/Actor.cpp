@@ -1,20 +1,31 @@
 #include "Actor.hpp"
 #include "Game.hpp"
 #include <algorithm>
+#include "Counters.hpp"
 
 Actor::Actor(Game* game) {
 	mGame = game;
-	mGame->AddActor(this);
+	mHandle = mGame->AddActor(this);
 
 	mState = State::EActive;
-	mPosition = Vector3::Zero;
-	mScale = 1.0f;
-	mRotation = Quaternion::Identity;
-	mRecomputeWorldTransform = true;
+	mStatic = false;
+	mDormant = false;
+	mInputSubscribed = false;
+	mComponentMask = 0;
+	mComponentTableDirty = false;
+
+	// starts out with an identity transform
+	mTransforms = mGame->GetTransformStore();
+	mTransformIndex = mTransforms->Add(this);
 }
 
 Actor::~Actor() {
 	mGame->RemoveActor(this);
+	if (mInputSubscribed) {
+		mGame->GetInputDispatcher()->Unsubscribe(this);
+		mInputSubscribed = false;
+	}
+	mTransforms->Remove(mTransformIndex);
 
 	// NOTE: DO NOT DELETE mGame POINTER BECAUSE IT WILL REMOVE THE GAME INSTANCE ITSELF!
 
@@ -25,43 +36,81 @@ Actor::~Actor() {
 	}
 }
 
-void Actor::Update(float deltaTime) {
+void Actor::Update(float deltaTime, int beginOrder, int endOrder) {
 	if (mState != State::EActive) {
 		return;
 	}
 
-	ComputeWorldTransform();
-
-	UpdateComponents(deltaTime);
-	UpdateActor(deltaTime);
-
-	ComputeWorldTransform();  // call it twice in case the transform changes in the interim
+	// world transforms are rebuilt for all actors at once by Game after the update
+	UpdateComponents(deltaTime, beginOrder, endOrder);
+	if (endOrder == INT_MAX) {
+		UpdateActor(deltaTime);
+	}
 }
 
-void Actor::UpdateComponents(float deltaTime) {
+void Actor::UpdateComponents(float deltaTime, int beginOrder, int endOrder) {
+	int64_t numUpdated = 0;
 	for (int i = 0; i < mComponents.size(); ++i) {
-		mComponents[i]->Update(deltaTime);
+		// sorted by update order, so everything after this is for a later phase
+		int order = mComponents[i]->GetUpdateOrder();
+		if (order >= endOrder && endOrder != INT_MAX) {
+			break;
+		}
+		// pooled components are updated with the rest of their type
+		if (order >= beginOrder && !mComponents[i]->IsPooled()) {
+			mComponents[i]->Update(deltaTime);
+			numUpdated += 1;
+		}
 	}
+	COUNTER_ADD("ComponentsUpdated", numUpdated);
 }
 
 void Actor::UpdateActor(float deltaTime) {
 
 }
 
-void Actor::ComputeWorldTransform() {
-	if (mRecomputeWorldTransform) {
-		mRecomputeWorldTransform = false;
-
-		// scale, then rotate, then translate
-		mWorldTransform = Matrix4::CreateScale(mScale);
-		mWorldTransform *= Matrix4::CreateFromQuaternion(mRotation);
-		mWorldTransform *= Matrix4::CreateTranslation(mPosition);
+void Actor::SetStatic(bool isStatic) {
+	mStatic = isStatic;
+	if (mStatic) {
+		mGame->QueueDormancyCheck(this);
+	}
+	else {
+		WakeIfDormant();
+	}
+}
 
-		// inform components world transform has updated
-		for (auto comp : mComponents) {
-			comp->OnUpdateWorldTransform();
+bool Actor::NeedsUpdate() const {
+	for (auto comp : mComponents) {
+		if (comp->NeedsUpdate()) {
+			return true;
 		}
 	}
+	return false;
+}
+
+void Actor::Wake() {
+	mGame->WakeActor(this);
+	// go back to sleep once the step is done, if there's still nothing to do
+	mGame->QueueDormancyCheck(this);
+}
+
+void Actor::SetParent(Actor* parent) {
+	size_t parentIndex = parent != nullptr ? parent->mTransformIndex : TransformStore::NoParent;
+	if (!mTransforms->SetParent(mTransformIndex, parentIndex)) {
+		SDL_Log("Can't attach an actor to itself or to one of its children");
+	}
+}
+
+Actor* Actor::GetParent() const {
+	size_t parentIndex = mTransforms->GetParent(mTransformIndex);
+	return parentIndex != TransformStore::NoParent ? mTransforms->GetOwner(parentIndex) : nullptr;
+}
+
+void Actor::OnWorldTransformUpdated() {
+	// inform components world transform has updated
+	for (auto comp : mComponents) {
+		comp->OnUpdateWorldTransform();
+	}
 }
 
 void Actor::ProcessInput(const uint8_t* keyState) {
@@ -81,6 +130,15 @@ void Actor::ActorInput(const uint8_t* keyState) {
 
 }
 
+void Actor::SubscribeInput(const InputDispatcher::KeySet& keys, uint64_t actions, bool mouse) {
+	mGame->GetInputDispatcher()->Subscribe(this, keys, actions, mouse);
+	mInputSubscribed = true;
+}
+
+void Actor::OnInput(const InputEvent*, size_t, const uint8_t* keyState) {
+	ProcessInput(keyState);
+}
+
 void Actor::AddComponent(Component* component) {
 	// find the insertion point in the sorted vector - the first element with a order higher than me
 	int updateOrder = component->GetUpdateOrder();
@@ -93,11 +151,46 @@ void Actor::AddComponent(Component* component) {
 	
 	// inserts element before position of iterator
 	mComponents.insert(iter, component);
+
+	// the new component may need updating
+	WakeIfDormant();
+	MarkComponentTableDirty();
 }
 
 void Actor::RemoveComponent(Component* component) {
 	auto iter = std::find(mComponents.begin(), mComponents.end(), component);
 	if (iter != mComponents.end()) {
 		mComponents.erase(iter);
+		MarkComponentTableDirty();
+	}
+}
+
+void Actor::MarkComponentTableDirty() {
+	if (!mComponentTableDirty) {
+		mComponentTableDirty = true;
+		mGame->QueueComponentIndex(this);
+	}
+}
+
+void Actor::RebuildComponentTable() const {
+	mComponentMask = 0;
+	for (auto comp : mComponents) {
+		mComponentMask |= comp->GetTypeMask();
 	}
+
+	// first component (in update order) for each bit
+	mComponentTable.assign(CountBits(mComponentMask), nullptr);
+	for (auto comp : mComponents) {
+		uint64_t typeMask = comp->GetTypeMask();
+		while (typeMask != 0) {
+			uint64_t typeBit = typeMask & (0 - typeMask);
+			Component*& entry = mComponentTable[CountBits(mComponentMask & (typeBit - 1))];
+			if (entry == nullptr) {
+				entry = comp;
+			}
+			typeMask &= typeMask - 1;
+		}
+	}
+
+	mComponentTableDirty = false;
 }
@@ -3,10 +3,21 @@
 #include <vector>
 #include "Math.hpp"
 #include "Component.hpp"
+#include "TransformStore.hpp"
+#include "ActorHandle.hpp"
+#include "InputDispatcher.hpp"
+#include "MemoryTracker.hpp"
 #include <cstdint>
+#include <climits>
 
-class Actor {
+class Actor : public InputListener {
 public:
+	// actors are charged to the EActors memory tag
+	static void* operator new(size_t size) {
+		MEMORY_TAG_SCOPE(EActors);
+		return ::operator new(size);
+	}
+
 	// used to track state of actor
 	enum State {
 		EActive,
@@ -19,9 +30,11 @@ public:
 	virtual ~Actor();
 
 	// update function called from Game (not overridable)
-	void Update(float deltaTime);
-	// updates all the components attached to the actor (not overridable)
-	void UpdateComponents(float deltaTime);
+	// Game updates in phases split by the pools' update orders (see ComponentPool.hpp): each phase updates the
+	// components with beginOrder <= update order < endOrder, and the last (endOrder = INT_MAX) the rest, then UpdateActor
+	void Update(float deltaTime, int beginOrder = INT_MIN, int endOrder = INT_MAX);
+	// updates the components attached to the actor in that range of update orders, except pooled ones (not overridable)
+	void UpdateComponents(float deltaTime, int beginOrder = INT_MIN, int endOrder = INT_MAX);
 	// any actor-specific update code (overridable)
 	virtual void UpdateActor(float deltaTime);
 	
@@ -30,37 +43,44 @@ public:
 	// any actor-specific input code (overridable)
 	virtual void ActorInput(const uint8_t* keyState);
 
+	// actors only get input after subscribing, and then only on frames where one of the keys
+	// (or the mouse motion, if mouse is true) changed
+	void SubscribeInput(const InputDispatcher::KeySet& keys, uint64_t actions = 0, bool mouse = false);
+	// runs ProcessInput with the current keyboard state
+	void OnInput(const InputEvent* events, size_t numEvents, const uint8_t* keyState) override;
+
 	// getters/setters
-	const Vector3& GetPosition() const {
-		return mPosition;
+	// (the transform itself lives in the game's TransformStore)
+	Vector3 GetPosition() const {
+		return mTransforms->GetPosition(mTransformIndex);
 	}
 	void SetPosition(const Vector3& pos) {
-		mPosition = pos;
-		mRecomputeWorldTransform = true;
+		mTransforms->SetPosition(mTransformIndex, pos);
+		WakeIfDormant();
 	}
 	float GetScale() const {
-		return mScale;
+		return mTransforms->GetScale(mTransformIndex);
 	}
 	void SetScale(float scale) {
-		mScale = scale;
-		mRecomputeWorldTransform = true;
+		mTransforms->SetScale(mTransformIndex, scale);
+		WakeIfDormant();
 	}
-	const Quaternion& GetRotation() const {
-		return mRotation;
+	Quaternion GetRotation() const {
+		return mTransforms->GetRotation(mTransformIndex);
 	}
 	void SetRotation(const Quaternion& rotation) {
-		mRotation = rotation;
-		mRecomputeWorldTransform = true;
+		mTransforms->SetRotation(mTransformIndex, rotation);
+		WakeIfDormant();
 	}
 
 	// transform the initial forward vector (+x) by the rotation quaternion
 	Vector3 GetForward() const {
-		return Vector3::Transform(Vector3::UnitX, mRotation);
+		return Vector3::Transform(Vector3::UnitX, GetRotation());
 	}
 
 	Vector3 GetRight() const {
 		// rotate right axis using quaternion rotation
-		return Vector3::Transform(Vector3::UnitY, mRotation);
+		return Vector3::Transform(Vector3::UnitY, GetRotation());
 	}
 
 	State GetState() const {
@@ -68,45 +88,124 @@ public:
 	}
 	void SetState(State state) {
 		mState = state;
+		// a dormant actor is never swept for deletion, so wake it up
+		WakeIfDormant();
+	}
+
+	// static actors never move on their own, so they skip the per-frame input/update loops
+	// (Game wakes them for a step if something else moves them)
+	void SetStatic(bool isStatic);
+	bool IsStatic() const {
+		return mStatic;
+	}
+	// true while the actor is in Game's dormant list
+	bool IsDormant() const {
+		return mDormant;
 	}
 
+	// does this actor have anything to do in ProcessInput/Update?
+	// default is true if any component needs updating; actors overriding UpdateActor or ActorInput
+	// must override this too and return true
+	virtual bool NeedsUpdate() const;
+
 	class Game* GetGame() {
 		return mGame;
 	}
 
+	// stable handle to this actor (resolve it with Game::GetActor)
+	ActorHandle GetHandle() const {
+		return mHandle;
+	}
+
 	// add/remove components
 	void AddComponent(Component* component);
 	void RemoveComponent(Component* component);
 
-	void ComputeWorldTransform();
+	// world matrix as of the last TransformStore::ComputeWorldTransforms
+	// attach to another actor (nullptr detaches), position/rotation/scale then become relative to the parent
+	// and the actor follows it without any per-frame code (the parent must outlive the attachment or
+	// the children are detached where they are when it's deleted)
+	void SetParent(Actor* parent);
+	Actor* GetParent() const;
+
 	const Matrix4& GetWorldTransform() const {
-		return mWorldTransform;
+		return mTransforms->GetWorldTransform(mTransformIndex);
+	}
+	// called by the TransformStore after it rebuilt this actor's world matrix
+	void OnWorldTransformUpdated();
+
+	// interpolated transform used when drawing
+	const Matrix4& GetRenderTransform() const {
+		return mTransforms->GetRenderTransform(mTransformIndex);
+	}
+	Vector3 GetRenderPosition() const {
+		return mTransforms->GetRenderPosition(mTransformIndex);
+	}
+	Quaternion GetRenderRotation() const {
+		return mTransforms->GetRenderRotation(mTransformIndex);
 	}
 
+	// first component (in update order) of type T or derived from T, or nullptr
+	// constant time: the type's bit in mComponentMask says if there is one, and the number of lower bits
+	// is its index in mComponentTable (T must use DECLARE_COMPONENT_TYPE)
 	template<typename T>
-	T GetComponent() const {
-		for (int i = 0; i < mComponents.size(); ++i) {
-			Component* comp = mComponents[i];
-			if (static_cast<T>(comp) != nullptr) {
-				return static_cast<T>(comp);
-			}
+	T* GetComponent() const {
+		uint64_t typeBit = 1ull << T::GetStaticTypeId();
+		uint64_t mask = GetComponentMask();
+		if ((mask & typeBit) == 0) {
+			return nullptr;
+		}
+		return static_cast<T*>(mComponentTable[CountBits(mask & (typeBit - 1))]);
+	}
+
+	// does this actor have a component of every listed type?
+	template<typename... Ts>
+	bool HasComponents() const {
+		uint64_t typeBits = ComponentTypeBits<Ts...>();
+		return (GetComponentMask() & typeBits) == typeBits;
+	}
+
+	// one bit per component type this actor has
+	uint64_t GetComponentMask() const {
+		if (mComponentTableDirty) {
+			RebuildComponentTable();
 		}
-		return nullptr;
+		return mComponentMask;
 	}
 
 private:
+	friend class TransformStore;
+	friend class Game;
+
+	void WakeIfDormant() {
+		if (mDormant) {
+			Wake();
+		}
+	}
+	void Wake();
+
+	// component types aren't known yet while a component's constructor runs (it adds itself from the
+	// base Component constructor), so the table is rebuilt on the first lookup after a change instead
+	void RebuildComponentTable() const;
+	void MarkComponentTableDirty();
+
 	// actor's state
 	State mState;
+	bool mStatic;
+	bool mDormant;
+	bool mInputSubscribed;
 
 	// transform
-	Vector3 mPosition;  // center position of actor
-	float mScale;  // uniform scale of actor (1.0f for 100%)
-	Quaternion mRotation;
-	Matrix4 mWorldTransform;  // need 4x4 matrix since the homogenous coords for 3D are (x,y,z,w)
-	bool mRecomputeWorldTransform;  // want to recompute world transform matrix only if the actor's position, scale, or rotation changes
+	class TransformStore* mTransforms;
+	size_t mTransformIndex;  // changes when another actor's transform is removed from the store
 
 	// components held by this actor
 	std::vector<Component*> mComponents;
+	// type lookup: a bit per component type, and one component per set bit (in bit order)
+	mutable uint64_t mComponentMask;
+	mutable std::vector<Component*> mComponentTable;
+	mutable bool mComponentTableDirty;
 
 	class Game* mGame;
+	ActorHandle mHandle;
 };
\ No newline at end of file
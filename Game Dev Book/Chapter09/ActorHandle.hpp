@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+// stable reference to an actor that can be checked for validity (see Game::GetActor)
+// - mIndex is the actor's slot in Game's slot map, and never changes for the actor's lifetime
+// - mGeneration is bumped every time the slot is freed, so handles to a deleted actor stop resolving
+//   even after the slot is reused
+struct ActorHandle {
+	ActorHandle() {
+		mIndex = 0;
+		mGeneration = 0;  // slots start at generation 1, so a default handle is never valid
+	}
+
+	ActorHandle(uint32_t index, uint32_t generation) {
+		mIndex = index;
+		mGeneration = generation;
+	}
+
+	bool operator==(const ActorHandle& other) const {
+		return mIndex == other.mIndex && mGeneration == other.mGeneration;
+	}
+
+	bool operator!=(const ActorHandle& other) const {
+		return !(*this == other);
+	}
+
+	uint32_t mIndex;
+	uint32_t mGeneration;
+};
@@ -1,12 +1,16 @@
 #pragma once
 
 #include "Component.hpp"
+#include "ComponentPool.hpp"
 #include "SoundEvent.hpp"
 #include <string>
 #include <vector>
 
 // associates sound events with specific actors and updates associated event's 3D attributes
 class AudioComponent : public Component {
+	DECLARE_POOLED_COMPONENT(AudioComponent, 200)
+	DECLARE_COMPONENT_TYPE(AudioComponent, Component)
+
 public:
 	AudioComponent(class Actor* owner, int updateOrder = 200);
 	~AudioComponent();
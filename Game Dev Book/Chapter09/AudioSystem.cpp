@@ -4,6 +4,25 @@
 #include <fmod_studio.hpp>
 #include <fmod_errors.h>
 #include "Math.hpp"
+#include "FrameAllocator.hpp"
+#include "Profiler.hpp"
+#include "Counters.hpp"
+#include "MemoryTracker.hpp"
+
+namespace {
+	// FMOD's own memory goes through the tracker too (as Audio)
+	void* F_CALLBACK FMODAlloc(unsigned int size, FMOD_MEMORY_TYPE type, const char* source) {
+		return MemoryTracker::Allocate(size, MemoryTracker::EAudio);
+	}
+
+	void* F_CALLBACK FMODRealloc(void* ptr, unsigned int size, FMOD_MEMORY_TYPE type, const char* source) {
+		return MemoryTracker::Reallocate(ptr, size, MemoryTracker::EAudio);
+	}
+
+	void F_CALLBACK FMODFree(void* ptr, FMOD_MEMORY_TYPE type, const char* source) {
+		MemoryTracker::Free(ptr);
+	}
+}
 
 unsigned int AudioSystem::sNextID = 0;
 
@@ -16,7 +35,16 @@ AudioSystem::AudioSystem(Game* game) {
 AudioSystem::~AudioSystem() {
 }
 
-bool AudioSystem::Initialize() {
+bool AudioSystem::Initialize(bool headless) {
+	if (headless) {
+		// leave mSystem null, everything below checks for it
+		return true;
+	}
+	MEMORY_TAG_SCOPE(EAudio);
+
+	// has to happen before anything else in FMOD
+	FMOD::Memory_Initialize(nullptr, 0, FMODAlloc, FMODRealloc, FMODFree);
+
 	// set up error logging
 	// first param specifies the verbosity of the logging messages
 	// second param specifies where to write log messages
@@ -67,7 +95,12 @@ void AudioSystem::Shutdown() {
 }
 
 SoundEvent AudioSystem::PlayEvent(const std::string& name) {
+	MEMORY_TAG_SCOPE(EAudio);
 	unsigned int retID = 0;
+	if (mSystem == nullptr) {
+		// id 0 is never a valid instance, so the returned event does nothing
+		return SoundEvent(this, retID);
+	}
 
 	// make sure event exists
 	auto it = mEvents.find(name);
@@ -89,8 +122,11 @@ SoundEvent AudioSystem::PlayEvent(const std::string& name) {
 }
 
 void AudioSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("AudioSystem::Update");
+    MEMORY_TAG_SCOPE(EAudio);
+
 	// find any stopped event instances
-	std::vector<unsigned int> done;
+	FrameVector<unsigned int> done;
 	for (auto& iter : mEventInstances) {
 		FMOD::Studio::EventInstance* e = iter.second;
 		// get the state of this event
@@ -107,14 +143,18 @@ void AudioSystem::Update(float deltaTime) {
 	for (auto id : done) {
 		mEventInstances.erase(id);
 	}
+	COUNTER_SET("AudioInstances", static_cast<int64_t>(mEventInstances.size()));
 
 	// update FMOD system
-	mSystem->update();
+	if (mSystem) {
+		mSystem->update();
+	}
 }
 
 void AudioSystem::LoadBank(const std::string& name) {
-	// prevent double-loading
-	if (mBanks.find(name) != mBanks.end()) {
+	MEMORY_TAG_SCOPE(EAudio);
+	// prevent double-loading (and loading without FMOD)
+	if (mSystem == nullptr || mBanks.find(name) != mBanks.end()) {
 		return;
 	}
 
@@ -252,6 +292,10 @@ namespace {
 }
 
 void AudioSystem::SetListener(const Matrix4& viewMatrix) {
+	if (mSystem == nullptr) {
+		return;
+	}
+
 	// invert the view matrix to get the correct vectors
 	Matrix4 invView = viewMatrix;
 	invView.Invert();
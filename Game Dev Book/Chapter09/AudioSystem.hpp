@@ -21,7 +21,8 @@ public:
 	AudioSystem(class Game* game);
 	~AudioSystem();
 
-	bool Initialize();
+	// headless = null audio backend: FMOD isn't created, and every call does nothing
+	bool Initialize(bool headless = false);
 	void Shutdown();
 
 	// load/unload banks
@@ -6,15 +6,28 @@
 
 CameraComponent::CameraComponent(Actor* owner, int updateOrder) : 
 	Component(owner, updateOrder) {
+	// most recently created camera becomes the active one
+	mOwner->GetGame()->GetRenderer()->SetCamera(this);
 }
 
 CameraComponent::~CameraComponent() {
+	Renderer* renderer = mOwner->GetGame()->GetRenderer();
+	if (renderer->GetCamera() == this) {
+		renderer->SetCamera(nullptr);
+	}
 	Component::~Component();
 }
 
 void CameraComponent::SetViewMatrix(const Matrix4& view) {
 	// pass view matrix to renderer and audio system
+	// (they're shared by every actor, so this is deferred until actors are done updating)
 	Game* game = mOwner->GetGame();
-	game->GetRenderer()->SetViewMatrix(view);
-	game->GetAudioSystem()->SetListener(view);
+	game->GetCommandBuffer().Run([game, view]() {
+		game->GetRenderer()->SetViewMatrix(view);
+		game->GetAudioSystem()->SetListener(view);
+	});
+}
+
+void CameraComponent::SetRenderViewMatrix(const Matrix4& view) {
+	mOwner->GetGame()->GetRenderer()->SetViewMatrix(view);
 }
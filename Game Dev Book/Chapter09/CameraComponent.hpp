@@ -4,10 +4,18 @@
 #include "Math.hpp"
 
 class CameraComponent : public Component {
+	DECLARE_COMPONENT_TYPE(CameraComponent, Component)
+
 public:
 	CameraComponent(class Actor* owner, int updateOrder = 200);
 	~CameraComponent();
 
+	// recompute the view from the owner's interpolated transform right before drawing
+	// (alpha is how far we are between the previous and current simulation step)
+	virtual void UpdateRenderView(float /*alpha*/) {}
+
 protected:
 	void SetViewMatrix(const Matrix4& view);
+	// only updates the renderer's view (the audio listener follows the simulation, not the display)
+	void SetRenderViewMatrix(const Matrix4& view);
 };
\ No newline at end of file
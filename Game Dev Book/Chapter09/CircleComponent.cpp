@@ -4,7 +4,7 @@ CircleComponent::CircleComponent(Actor* owner) : Component(owner) {
 	mRadius = 0.0f;
 }
 
-const Vector3& CircleComponent::GetCenter() const {
+Vector3 CircleComponent::GetCenter() const {
 	return mOwner->GetPosition();
 }
 
@@ -5,9 +5,16 @@
 #include "Actor.hpp"
 
 class CircleComponent : public Component {
+	DECLARE_COMPONENT_TYPE(CircleComponent, Component)
+
 public:
 	CircleComponent(class Actor* owner);
 
+	// only drawn/queried, never updated
+	bool NeedsUpdate() const override {
+		return false;
+	}
+
 	void SetRadius(float radius) {
 		mRadius = radius;
 	}
@@ -16,7 +23,7 @@ public:
 		return mRadius * mOwner->GetScale();
 	}
 
-	const Vector3& GetCenter() const;  // the center will be the position of owning actor
+	Vector3 GetCenter() const;  // the center will be the position of owning actor
 
 private:
 	float mRadius;
@@ -0,0 +1,90 @@
+#include "CommandBuffer.hpp"
+#include "Game.hpp"
+#include "Actor.hpp"
+
+void CommandBuffer::Spawn(const std::function<void(Game*)>& fn) {
+	Command c;
+	c.mType = ESpawn;
+	c.mFunction = mSpawnFns.size();
+	mSpawnFns.emplace_back(fn);
+	mCommands.emplace_back(c);
+}
+
+void CommandBuffer::Destroy(ActorHandle actor) {
+	Command c;
+	c.mType = EDestroy;
+	c.mActor = actor;
+	mCommands.emplace_back(c);
+}
+
+void CommandBuffer::SetPosition(ActorHandle actor, const Vector3& pos) {
+	Command c;
+	c.mType = ESetPosition;
+	c.mActor = actor;
+	c.mPosition = pos;
+	mCommands.emplace_back(c);
+}
+
+void CommandBuffer::SetRotation(ActorHandle actor, const Quaternion& rotation) {
+	Command c;
+	c.mType = ESetRotation;
+	c.mActor = actor;
+	c.mRotation = rotation;
+	mCommands.emplace_back(c);
+}
+
+void CommandBuffer::SetScale(ActorHandle actor, float scale) {
+	Command c;
+	c.mType = ESetScale;
+	c.mActor = actor;
+	c.mScale = scale;
+	mCommands.emplace_back(c);
+}
+
+void CommandBuffer::Run(const std::function<void()>& fn) {
+	Command c;
+	c.mType = ERun;
+	c.mFunction = mRunFns.size();
+	mRunFns.emplace_back(fn);
+	mCommands.emplace_back(c);
+}
+
+void CommandBuffer::Execute(Game* game) {
+	for (const Command& c : mCommands) {
+		switch (c.mType) {
+		case ESpawn:
+			mSpawnFns[c.mFunction](game);
+			break;
+		case ERun:
+			mRunFns[c.mFunction]();
+			break;
+		default:
+		{
+			// everything else targets an actor, which may have been deleted since
+			Actor* actor = game->GetActor(c.mActor);
+			if (actor == nullptr) {
+				break;
+			}
+
+			if (c.mType == EDestroy) {
+				actor->SetState(Actor::EDead);
+			}
+			else if (c.mType == ESetPosition) {
+				actor->SetPosition(c.mPosition);
+			}
+			else if (c.mType == ESetRotation) {
+				actor->SetRotation(c.mRotation);
+			}
+			else if (c.mType == ESetScale) {
+				actor->SetScale(c.mScale);
+			}
+			break;
+		}
+		}
+	}
+
+	// clear() keeps the capacity, so steady-state recording doesn't allocate
+	mCommands.clear();
+	mSpawnFns.clear();
+	mRunFns.clear();
+}
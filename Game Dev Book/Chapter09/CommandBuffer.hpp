@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include "Math.hpp"
+#include "ActorHandle.hpp"
+
+// records changes that can't safely happen while actors update in parallel, and applies them
+// later on the main thread (Game executes every buffer at the sync point after the actor update)
+// - structural changes: creating actors, killing other actors
+// - writes to other actors' transforms, or to shared systems (renderer, audio)
+// actors are referenced by handle, so commands targeting an actor deleted in the meantime are dropped
+class CommandBuffer {
+public:
+	// runs fn (which creates actors) at the sync point
+	void Spawn(const std::function<void(class Game*)>& fn);
+	// marks an actor as dead
+	void Destroy(ActorHandle actor);
+
+	// transform writes to another actor
+	void SetPosition(ActorHandle actor, const Vector3& pos);
+	void SetRotation(ActorHandle actor, const Quaternion& rotation);
+	void SetScale(ActorHandle actor, float scale);
+
+	// any other write to shared state
+	void Run(const std::function<void()>& fn);
+
+	// apply the commands in the order they were recorded, then clear the buffer
+	void Execute(class Game* game);
+
+	bool IsEmpty() const {
+		return mCommands.empty();
+	}
+
+private:
+	enum Type {
+		ESpawn,
+		EDestroy,
+		ESetPosition,
+		ESetRotation,
+		ESetScale,
+		ERun
+	};
+
+	struct Command {
+		Type mType;
+		ActorHandle mActor;
+		Vector3 mPosition;
+		Quaternion mRotation;
+		float mScale;
+		// index into mSpawnFns/mRunFns
+		size_t mFunction;
+	};
+
+	std::vector<Command> mCommands;
+	std::vector<std::function<void(class Game*)>> mSpawnFns;
+	std::vector<std::function<void()>> mRunFns;
+};
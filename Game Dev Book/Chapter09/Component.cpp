@@ -1,9 +1,13 @@
 #include "Component.hpp"
 #include "Actor.hpp"
+#include "ComponentPool.hpp"
+#include "SDL/SDL.h"
+#include <atomic>
 
 Component::Component(Actor* owner, int updateOrder) {
 	mOwner = owner;
 	mUpdateOrder = updateOrder;
+	mPooled = -1;
 
 	// add to actor's vector of components
 	owner->AddComponent(this);
@@ -15,6 +19,17 @@ Component::~Component() {
 	// NOTE: DO NOT DELETE mOwner POINTER BECAUSE IT WILL REMOVE THE OWNER ACTOR INSTANCE ITSELF
 }
 
+uint32_t Component::RegisterType(const char* name) {
+	static std::atomic<uint32_t> sNextTypeId(0);
+	uint32_t id = sNextTypeId.fetch_add(1);
+	if (id >= MaxTypes) {
+		// out of bits: share the last one (lookups for these types can return the wrong type)
+		SDL_Log("Too many component types, %s shares type id %u", name, MaxTypes - 1);
+		id = MaxTypes - 1;
+	}
+	return id;
+}
+
 void Component::Update(float deltaTime) {
 
 }
\ No newline at end of file
@@ -1,9 +1,17 @@
 #pragma once
 
 #include <cstdint>
+#include <bitset>
+#include "MemoryTracker.hpp"
 
 class Component {
 public:
+	// components are charged to the EActors memory tag (pooled types use their pool, which is too)
+	static void* operator new(size_t size) {
+		MEMORY_TAG_SCOPE(EActors);
+		return ::operator new(size);
+	}
+
 	// constructor
 	// (the lower the update order, the earlier the component updates)
 	Component(class Actor* owner, int updateOrder = 100);
@@ -19,14 +27,84 @@ public:
 	// called to notify components when their owning actor's world transform gets updated
 	virtual void OnUpdateWorldTransform() {}
 
+	// does this component do anything in Update/ProcessInput? (actors with no such components can sleep)
+	virtual bool NeedsUpdate() const {
+		return true;
+	}
+
 	int GetUpdateOrder() const {
 		return mUpdateOrder;
 	}
 
+	class Actor* GetOwner() const {
+		return mOwner;
+	}
+
+	// pooled components are updated by their ComponentPool instead of by the owning actor
+	// (asked of the pool the first time, once the component is fully constructed)
+	bool IsPooled() const {
+		if (mPooled < 0) {
+			mPooled = IsInPool() ? 1 : 0;
+		}
+		return mPooled != 0;
+	}
+
+	// component types get an id (a bit in a 64-bit mask) so actors can look components up without a scan
+	static const uint32_t MaxTypes = 64;
+	// Component itself has no bit
+	static uint64_t GetStaticTypeMask() {
+		return 0;
+	}
+	// bits of this component's type and of every base type (set up by DECLARE_COMPONENT_TYPE)
+	virtual uint64_t GetTypeMask() const {
+		return 0;
+	}
+	// hand out the next free type id (called once per type)
+	static uint32_t RegisterType(const char* name);
+
 protected:
+	// does this component live in a ComponentPool? (overridden by DECLARE_POOLED_COMPONENT)
+	virtual bool IsInPool() const {
+		return false;
+	}
+
 	// owning actor
 	class Actor* mOwner;
 
 	// update order of component
 	int mUpdateOrder;
-};
\ No newline at end of file
+
+	// 1 if this component lives in a ComponentPool, 0 if not, -1 until IsPooled first asks
+	mutable int8_t mPooled;
+};
+
+// give a component type its type id, put it in the class declaration with its direct base
+// (Component for most types), e.g. DECLARE_COMPONENT_TYPE(FPSCamera, CameraComponent)
+// a component is found by lookups/queries for its own type and for each of its base types
+#define DECLARE_COMPONENT_TYPE(type, base) \
+public: \
+	static uint32_t GetStaticTypeId() { \
+		static const uint32_t id = Component::RegisterType(#type); \
+		return id; \
+	} \
+	static uint64_t GetStaticTypeMask() { \
+		return (1ull << GetStaticTypeId()) | base::GetStaticTypeMask(); \
+	} \
+	uint64_t GetTypeMask() const override { \
+		return GetStaticTypeMask(); \
+	}
+
+// mask with the bit of every listed type, e.g. ComponentTypeBits<MoveComponent, CircleComponent>()
+template<typename T>
+uint64_t ComponentTypeBits() {
+	return 1ull << T::GetStaticTypeId();
+}
+template<typename T, typename U, typename... Rest>
+uint64_t ComponentTypeBits() {
+	return ComponentTypeBits<T>() | ComponentTypeBits<U, Rest...>();
+}
+
+// number of set bits (index into an actor's component table)
+inline uint32_t CountBits(uint64_t bits) {
+	return static_cast<uint32_t>(std::bitset<64>(bits).count());
+}
\ No newline at end of file
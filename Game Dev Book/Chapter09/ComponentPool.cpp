@@ -0,0 +1,39 @@
+#include "ComponentPool.hpp"
+#include "Component.hpp"
+#include "Actor.hpp"
+#include <algorithm>
+
+ComponentPoolBase::ComponentPoolBase(int updateOrder) {
+	mUpdateOrder = updateOrder;
+
+	// find the insertion point in the sorted vector - the first pool with a order higher than me
+	std::vector<ComponentPoolBase*>& pools = GetPoolList();
+	auto iter = pools.begin();
+	for (; iter != pools.end(); ++iter) {
+		if ((*iter)->GetUpdateOrder() > updateOrder) {
+			break;
+		}
+	}
+
+	// inserts element before position of iterator
+	pools.insert(iter, this);
+}
+
+ComponentPoolBase::~ComponentPoolBase() {
+	std::vector<ComponentPoolBase*>& pools = GetPoolList();
+	auto iter = std::find(pools.begin(), pools.end(), this);
+	if (iter != pools.end()) {
+		pools.erase(iter);
+	}
+}
+
+bool ComponentPoolBase::IsOwnerActive(const Component* component) {
+	Actor* owner = component->GetOwner();
+	return owner->GetState() == Actor::EActive && !owner->IsDormant();
+}
+
+std::vector<ComponentPoolBase*>& ComponentPoolBase::GetPoolList() {
+	// function-local so it exists before the first pool registers itself
+	static std::vector<ComponentPoolBase*> pools;
+	return pools;
+}
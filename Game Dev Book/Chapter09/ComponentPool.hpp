@@ -0,0 +1,234 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include "WorkerPool.hpp"
+#include "Profiler.hpp"
+#include "Counters.hpp"
+#include "MemoryTracker.hpp"
+#include "SDL/SDL.h"
+
+// components can opt into living in a per-type pool instead of being scattered across the heap
+// - each pooled type gets contiguous chunks of storage, with a bit per slot marking which slots are in use
+// - Game updates every pool once per step, with one tight loop per type (a direct, non-virtual call
+//   to the type's Update instead of a virtual call per component); the actors' non-pooled components
+//   update in phases between the pools, so a non-pooled component with a lower update order than a
+//   pool still runs before it, and one with a higher order after it
+// - given a WorkerPool, the chunks of a pool are spread across threads (one type still finishes
+//   before the next one starts, so update order holds)
+// - Actor::UpdateComponents skips pooled components, so they aren't updated twice
+//
+// to opt in, put DECLARE_POOLED_COMPONENT(Type, updateOrder) in the class declaration
+// (the pool's updateOrder is the one every component of the type updates at, so it must match the
+// order passed to Component's constructor - a mismatch is logged)
+// NOTE: a class derived from a pooled component must declare the macro itself, otherwise it would
+// be updated as its base type
+
+// type-independent part of a pool, and the list of every pool
+class ComponentPoolBase {
+public:
+	ComponentPoolBase(int updateOrder);
+	virtual ~ComponentPoolBase();
+
+	// update every live component of this pool (in parallel if workers isn't null)
+	virtual void UpdateAll(float deltaTime, class WorkerPool* workers) = 0;
+
+	int GetUpdateOrder() const {
+		return mUpdateOrder;
+	}
+
+	// every pool, sorted by update order (the lower the update order, the earlier the pool updates)
+	static const std::vector<ComponentPoolBase*>& GetPools() {
+		return GetPoolList();
+	}
+
+protected:
+	// pooled components are only updated while their owner is active (same as Actor::Update)
+	static bool IsOwnerActive(const class Component* component);
+
+private:
+	// every pool, sorted by update order
+	static std::vector<ComponentPoolBase*>& GetPoolList();
+
+	int mUpdateOrder;
+};
+
+template <typename T>
+class ComponentPool : public ComponentPoolBase {
+public:
+	// one pool per type, created the first time a component of that type is allocated
+	static ComponentPool<T>& Get() {
+		static ComponentPool<T> pool;
+		return pool;
+	}
+
+	~ComponentPool() {
+		for (auto chunk : mChunks) {
+			delete chunk;
+		}
+	}
+
+	void* Allocate(size_t size) {
+		MEMORY_TAG_SCOPE(EActors);
+		// a derived type that didn't opt in is bigger than a slot, so it goes on the regular heap
+		if (size != sizeof(T)) {
+			return ::operator new(size);
+		}
+
+		// find a chunk with a free slot
+		Chunk* chunk = nullptr;
+		for (auto c : mChunks) {
+			if ((c->mLive | c->mPending) != ~0ull) {
+				chunk = c;
+				break;
+			}
+		}
+		if (chunk == nullptr) {
+			chunk = new Chunk();
+			chunk->mLive = 0;
+			chunk->mPending = 0;
+			mChunks.emplace_back(chunk);
+		}
+
+		// first free slot in the chunk
+		uint64_t used = chunk->mLive | chunk->mPending;
+		size_t slot = 0;
+		while (used & (1ull << slot)) {
+			slot += 1;
+		}
+
+		// components created while the pool is updating don't update until the next step
+		// (same as actors created while updating actors)
+		if (mUpdating) {
+			chunk->mPending |= 1ull << slot;
+		}
+		else {
+			chunk->mLive |= 1ull << slot;
+		}
+
+		return chunk->mData[slot];
+	}
+
+	// is ptr a slot of this pool? (not a derived type that went on the heap)
+	bool Owns(const void* ptr) const {
+		for (auto chunk : mChunks) {
+			const unsigned char* p = static_cast<const unsigned char*>(ptr);
+			if (p >= chunk->mData[0] && p < chunk->mData[ChunkSize]) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Free(void* ptr) {
+		for (auto chunk : mChunks) {
+			unsigned char* begin = chunk->mData[0];
+			unsigned char* end = chunk->mData[ChunkSize];
+			unsigned char* p = static_cast<unsigned char*>(ptr);
+			if (p >= begin && p < end) {
+				size_t slot = (p - begin) / sizeof(T);
+				chunk->mLive &= ~(1ull << slot);
+				chunk->mPending &= ~(1ull << slot);
+				return;
+			}
+		}
+
+		// not from this pool
+		::operator delete(ptr);
+	}
+
+	void UpdateAll(float deltaTime, WorkerPool* workers) override {
+		// time per component type
+		PROFILE_SCOPE(T::GetPoolName());
+
+		mUpdating = true;
+		if (workers != nullptr) {
+			// components can't be created or deleted from another thread (that goes through a CommandBuffer),
+			// so the chunk list is fixed for the duration
+			workers->ParallelFor(mChunks.size(), 1, [this, deltaTime](size_t begin, size_t end) {
+				PROFILE_SCOPE(T::GetPoolName());
+				for (size_t c = begin; c < end; ++c) {
+					UpdateChunk(mChunks[c], deltaTime);
+				}
+			});
+		}
+		else {
+			// index loop, since updating a component can allocate a new chunk
+			for (size_t c = 0; c < mChunks.size(); ++c) {
+				UpdateChunk(mChunks[c], deltaTime);
+			}
+		}
+		mUpdating = false;
+
+		// components created during the update are live from now on
+		for (auto chunk : mChunks) {
+			chunk->mLive |= chunk->mPending;
+			chunk->mPending = 0;
+		}
+	}
+
+private:
+	struct Chunk;
+
+	void UpdateChunk(Chunk* chunk, float deltaTime) {
+		int64_t numUpdated = 0;
+		for (size_t slot = 0; slot < ChunkSize; ++slot) {
+			// re-check the live bit every time, in case an earlier update deleted this component
+			if (chunk->mLive & (1ull << slot)) {
+				T* comp = reinterpret_cast<T*>(chunk->mData[slot]);
+				if (IsOwnerActive(comp)) {
+					comp->T::Update(deltaTime);
+					numUpdated += 1;
+				}
+			}
+		}
+		COUNTER_ADD("ComponentsUpdated", numUpdated);
+	}
+
+	ComponentPool() : ComponentPoolBase(T::PoolUpdateOrder) {
+		mUpdating = false;
+	}
+
+	// one bit per slot, so 64 slots per chunk
+	static const size_t ChunkSize = 64;
+
+	struct Chunk {
+		alignas(T) unsigned char mData[ChunkSize][sizeof(T)];
+		// slots holding a component that gets updated
+		uint64_t mLive;
+		// slots allocated during UpdateAll (become live once it finishes)
+		uint64_t mPending;
+	};
+
+	// chunks are never moved or freed while the pool exists, so components keep their address
+	std::vector<Chunk*> mChunks;
+	// track if we are updating this pool right now
+	bool mUpdating;
+};
+
+// route a component type's new/delete through its pool
+#define DECLARE_POOLED_COMPONENT(type, updateOrder) \
+public: \
+	static const int PoolUpdateOrder = updateOrder; \
+	static const char* GetPoolName() { \
+		return #type; \
+	} \
+	static void* operator new(size_t size) { \
+		return ComponentPool<type>::Get().Allocate(size); \
+	} \
+	static void operator delete(void* ptr) { \
+		ComponentPool<type>::Get().Free(ptr); \
+	} \
+protected: \
+	bool IsInPool() const override { \
+		if (!ComponentPool<type>::Get().Owns(this)) { \
+			return false; \
+		} \
+		if (mUpdateOrder != PoolUpdateOrder) { \
+			SDL_Log("%s has update order %d, but its pool updates at %d", #type, mUpdateOrder, PoolUpdateOrder); \
+		} \
+		return true; \
+	} \
+public:
@@ -0,0 +1,182 @@
+#include "Counters.hpp"
+#include "SDL/SDL.h"
+#include <atomic>
+#include <mutex>
+#include <fstream>
+#include <cstring>
+
+namespace {
+	// everything here is plain static storage (no constructors that allocate), since operator new uses it
+	std::mutex sRegisterMutex;
+	std::atomic<uint32_t> sNumCounters(0);
+	const char* sNames[Counters::MaxCounters];
+	Counters::Kind sKinds[Counters::MaxCounters];
+	std::atomic<int64_t> sValues[Counters::MaxCounters];
+
+	// history ring, one row per finished frame
+	int64_t sHistory[Counters::HistorySize][Counters::MaxCounters];
+	uint32_t sNumFrames = 0;
+
+	std::atomic<int64_t> sHeapAllocs(0);
+	std::atomic<int64_t> sHeapBytes(0);
+
+	const int64_t* GetRow(uint32_t framesAgo) {
+		return sHistory[(sNumFrames - 1 - framesAgo) % Counters::HistorySize];
+	}
+}
+
+uint32_t Counters::Register(const char* name, Kind kind) {
+	std::lock_guard<std::mutex> lock(sRegisterMutex);
+
+	uint32_t id = Find(name);
+	if (id != InvalidId) {
+		return id;
+	}
+
+	id = sNumCounters.load(std::memory_order_relaxed);
+	if (id >= MaxCounters) {
+		SDL_Log("Too many counters, %s is not counted", name);
+		return InvalidId;
+	}
+
+	sNames[id] = name;
+	sKinds[id] = kind;
+	sValues[id].store(0, std::memory_order_relaxed);
+	for (auto& row : sHistory) {
+		row[id] = 0;
+	}
+	// publish the counter after its name is set
+	sNumCounters.store(id + 1, std::memory_order_release);
+	return id;
+}
+
+uint32_t Counters::Find(const char* name) {
+	uint32_t numCounters = sNumCounters.load(std::memory_order_acquire);
+	for (uint32_t id = 0; id < numCounters; ++id) {
+		if (strcmp(sNames[id], name) == 0) {
+			return id;
+		}
+	}
+	return InvalidId;
+}
+
+void Counters::Add(uint32_t id, int64_t value) {
+	if (id < MaxCounters) {
+		sValues[id].fetch_add(value, std::memory_order_relaxed);
+	}
+}
+
+void Counters::Set(uint32_t id, int64_t value) {
+	if (id < MaxCounters) {
+		sValues[id].store(value, std::memory_order_relaxed);
+	}
+}
+
+void Counters::EndFrame() {
+	// heap counters are plain atomics (registering from inside operator new isn't safe)
+	static const uint32_t heapAllocsId = Register("HeapAllocs");
+	static const uint32_t heapBytesId = Register("HeapBytes");
+	Add(heapAllocsId, sHeapAllocs.exchange(0, std::memory_order_relaxed));
+	Add(heapBytesId, sHeapBytes.exchange(0, std::memory_order_relaxed));
+
+	int64_t* row = sHistory[sNumFrames % HistorySize];
+	uint32_t numCounters = sNumCounters.load(std::memory_order_acquire);
+	for (uint32_t id = 0; id < numCounters; ++id) {
+		if (sKinds[id] == EPerFrame) {
+			row[id] = sValues[id].exchange(0, std::memory_order_relaxed);
+		}
+		else {
+			row[id] = sValues[id].load(std::memory_order_relaxed);
+		}
+	}
+	sNumFrames += 1;
+}
+
+uint32_t Counters::GetNumCounters() {
+	return sNumCounters.load(std::memory_order_acquire);
+}
+
+const char* Counters::GetName(uint32_t id) {
+	return id < GetNumCounters() ? sNames[id] : "";
+}
+
+uint32_t Counters::GetNumFrames() {
+	return sNumFrames < HistorySize ? sNumFrames : HistorySize;
+}
+
+int64_t Counters::GetValue(uint32_t id, uint32_t framesAgo) {
+	if (id >= GetNumCounters() || framesAgo >= GetNumFrames()) {
+		return 0;
+	}
+	return GetRow(framesAgo)[id];
+}
+
+double Counters::GetAverage(uint32_t id, uint32_t numFrames) {
+	if (numFrames > GetNumFrames()) {
+		numFrames = GetNumFrames();
+	}
+	if (id >= GetNumCounters() || numFrames == 0) {
+		return 0.0;
+	}
+
+	int64_t total = 0;
+	for (uint32_t i = 0; i < numFrames; ++i) {
+		total += GetRow(i)[id];
+	}
+	return static_cast<double>(total) / numFrames;
+}
+
+int64_t Counters::GetMax(uint32_t id, uint32_t numFrames) {
+	if (numFrames > GetNumFrames()) {
+		numFrames = GetNumFrames();
+	}
+	if (id >= GetNumCounters() || numFrames == 0) {
+		return 0;
+	}
+
+	int64_t max = GetRow(0)[id];
+	for (uint32_t i = 1; i < numFrames; ++i) {
+		if (GetRow(i)[id] > max) {
+			max = GetRow(i)[id];
+		}
+	}
+	return max;
+}
+
+void Counters::LogSummary() {
+	SDL_Log("Counters over the last %u frames (avg / max):", GetNumFrames());
+	for (uint32_t id = 0; id < GetNumCounters(); ++id) {
+		SDL_Log("  %-24s %12.1f %10lld", sNames[id], GetAverage(id), static_cast<long long>(GetMax(id)));
+	}
+}
+
+bool Counters::WriteCSV(const std::string& fileName) {
+	std::ofstream file(fileName);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	uint32_t numCounters = GetNumCounters();
+	file << "frame";
+	for (uint32_t id = 0; id < numCounters; ++id) {
+		file << "," << sNames[id];
+	}
+	file << "\n";
+
+	// oldest frame first
+	uint32_t numFrames = GetNumFrames();
+	for (uint32_t framesAgo = numFrames; framesAgo-- > 0; ) {
+		file << sNumFrames - 1 - framesAgo;
+		const int64_t* row = GetRow(framesAgo);
+		for (uint32_t id = 0; id < numCounters; ++id) {
+			file << "," << row[id];
+		}
+		file << "\n";
+	}
+	return true;
+}
+
+void Counters::CountAllocation(size_t size) {
+	sHeapAllocs.fetch_add(1, std::memory_order_relaxed);
+	sHeapBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// named per-frame counters (draw calls, binds, allocations, ...) with a rolling history, to explain
+// changes in frame time that timings alone don't
+// - COUNTER_ADD("name", n) adds to a counter that restarts from 0 every frame
+// - COUNTER_SET("name", n) sets a gauge, which keeps its value until it's set again
+// - Counters::EndFrame() pushes every counter's value into the history (once per frame)
+// - heap allocations (global operator new) are counted as "HeapAllocs"/"HeapBytes"
+// adding is a relaxed atomic add, so counters can be hit from worker threads
+class Counters {
+public:
+	enum Kind {
+		EPerFrame,
+		EGauge
+	};
+
+	// find or create a counter, returns its id
+	static uint32_t Register(const char* name, Kind kind = EPerFrame);
+	// id of a registered counter, or InvalidId
+	static uint32_t Find(const char* name);
+
+	static void Add(uint32_t id, int64_t value);
+	static void Set(uint32_t id, int64_t value);
+
+	// store this frame's values in the history and restart the per-frame counters
+	static void EndFrame();
+
+	// queries over the history (framesAgo 0 is the last finished frame)
+	static uint32_t GetNumCounters();
+	static const char* GetName(uint32_t id);
+	static int64_t GetValue(uint32_t id, uint32_t framesAgo = 0);
+	static double GetAverage(uint32_t id, uint32_t numFrames = HistorySize);
+	static int64_t GetMax(uint32_t id, uint32_t numFrames = HistorySize);
+	// number of finished frames in the history
+	static uint32_t GetNumFrames();
+
+	// log the average/max of every counter over the history
+	static void LogSummary();
+	// write the history as CSV (one row per frame, one column per counter), returns false on failure
+	static bool WriteCSV(const std::string& fileName);
+
+	// called from the global operator new (see MemoryTracker.cpp)
+	static void CountAllocation(size_t size);
+
+	static const uint32_t MaxCounters = 64;
+	static const uint32_t HistorySize = 300;
+	static const uint32_t InvalidId = ~0u;
+};
+
+// the id is looked up once per call site
+#define COUNTER_ADD(name, value) \
+	do { \
+		static const uint32_t counterId = Counters::Register(name); \
+		Counters::Add(counterId, value); \
+	} while (0)
+#define COUNTER_SET(name, value) \
+	do { \
+		static const uint32_t counterId = Counters::Register(name, Counters::EGauge); \
+		Counters::Set(counterId, value); \
+	} while (0)
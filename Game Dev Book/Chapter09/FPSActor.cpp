@@ -14,6 +14,15 @@ FPSActor::FPSActor(Game* game) : Actor(game) {
 	mFPSModel = new Actor(game);
 	mFPSModel->SetScale(0.75f);
 	mMeshComp = new MeshComponent(mFPSModel, game->GetRenderer()->GetMesh("Assets/Rifle.gpmesh"));
+
+	// the model is attached, so it follows the actor's position and yaw on its own
+	// (the offset is in the actor's space: forward, right, up)
+	mFPSModel->SetParent(this);
+	mFPSModel->SetPosition(Vector3(10.0f, 10.0f, -10.0f));
+	mModelPitch = 0.0f;
+
+	// movement keys and mouse look
+	SubscribeInput(InputDispatcher::MakeKeySet({ SDL_SCANCODE_W, SDL_SCANCODE_A, SDL_SCANCODE_S, SDL_SCANCODE_D }), 0, true);
 }
 
 FPSActor::~FPSActor() {
@@ -23,19 +32,14 @@ FPSActor::~FPSActor() {
 void FPSActor::UpdateActor(float deltaTime) {
 	Actor::UpdateActor(deltaTime);
 
-	// update position of FPS model relative to actor position
-	const Vector3 modelOffset(Vector3(10.0f, 10.0f, -10.0f));
-	Vector3 modelPos = GetPosition();
-	modelPos += GetForward() * modelOffset.x;
-	modelPos += GetRight() * modelOffset.y;
-	modelPos.z += modelOffset.z;
-	mFPSModel->SetPosition(modelPos);
-
-	// initialize rotation to actor rotation
-	Quaternion q = GetRotation();
-	// rotate by pitch from camera
-	q = Quaternion::Concatenate(q, Quaternion(GetRight(), mCameraComp->GetPitch()));
-	mFPSModel->SetRotation(q);
+	// the model only needs the camera's pitch on top of what it inherits (about its local right axis),
+	// and only when the pitch changed
+	float pitch = mCameraComp->GetPitch();
+	if (pitch != mModelPitch) {
+		mModelPitch = pitch;
+		// the model is a separate actor, so the write is deferred (it may be updating on another thread)
+		GetGame()->GetCommandBuffer().SetRotation(mFPSModel->GetHandle(), Quaternion(Vector3::UnitY, pitch));
+	}
 }
 
 void FPSActor::ActorInput(const uint8_t* keyState) {
@@ -60,9 +64,9 @@ void FPSActor::ActorInput(const uint8_t* keyState) {
 	mMoveComp->SetStrafeSpeed(strafeSpeed);
 
 	// convert mouse left/right movements to angular speed
-	// first get relative mouse movement (between frames)
+	// first get relative mouse movement (between frames, read once by Game)
 	int x, y;
-	Uint32 buttons = SDL_GetRelativeMouseState(&x, &y);
+	GetGame()->GetInputDispatcher()->GetMouseDelta(x, y);
 	// assume mouse movement is usually between -500 and +500 (between frames)
 	const int maxMouseSpeed = 500;
 	// rotation/sec at maximum speed
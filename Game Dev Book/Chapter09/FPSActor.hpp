@@ -10,10 +10,15 @@ public:
 
 	void UpdateActor(float deltaTime) override;
 	void ActorInput(const uint8_t* keyState) override;
+	bool NeedsUpdate() const override {
+		return true;
+	}
 
 private:
 	class MoveComponent* mMoveComp;
 	class FPSCamera* mCameraComp;
 	class Actor* mFPSModel;
 	class MeshComponent* mMeshComp;
+	// camera pitch the model was last rotated to
+	float mModelPitch;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@ FPSCamera::FPSCamera(Actor* owner) : CameraComponent(owner) {
 	mPitchSpeed = 0.0f;
 	mMaxPitch = Math::Pi / 3.0f;
 	mPitch = 0.0f;
+	mPrevPitch = 0.0f;
 }
 
 FPSCamera::~FPSCamera() {
@@ -15,24 +16,39 @@ void FPSCamera::Update(float deltaTime) {
 	// call parent update
 	CameraComponent::Update(deltaTime);
 
-	// camera position is owner position
-	Vector3 cameraPos = mOwner->GetPosition();
-
 	// update pitch based on pitch speed
+	mPrevPitch = mPitch;
 	mPitch += deltaTime * mPitchSpeed;
 	// clamp pitch to [-max, +max]
 	mPitch = Math::Clamp(mPitch, -mMaxPitch, mMaxPitch);
+
+	// camera position is owner position
+	Matrix4 view = ComputeView(mOwner->GetPosition(), mOwner->GetRotation(), mPitch);
+	SetViewMatrix(view);
+}
+
+void FPSCamera::UpdateRenderView(float alpha) {
+	// follow the owner's interpolated transform and blend the pitch the same way
+	float pitch = Math::Lerp(mPrevPitch, mPitch, alpha);
+	Matrix4 view = ComputeView(mOwner->GetRenderPosition(), mOwner->GetRenderRotation(), pitch);
+	SetRenderViewMatrix(view);
+}
+
+Matrix4 FPSCamera::ComputeView(const Vector3& position, const Quaternion& rotation, float pitch) const {
+	// owner's forward/right for this rotation
+	Vector3 forward = Vector3::Transform(Vector3::UnitX, rotation);
+	Vector3 right = Vector3::Transform(Vector3::UnitY, rotation);
+
 	// construct a quaternion representing this pitch rotation which is about owner's right vector
-	Quaternion q(mOwner->GetRight(), mPitch);
+	Quaternion q(right, pitch);
 
 	// rotate owner's forward vector by this pitch rotation quaternion
-	Vector3 viewForward = Vector3::Transform(mOwner->GetForward(), q);
+	Vector3 viewForward = Vector3::Transform(forward, q);
 	// target position 100 units in front of view forward
-	Vector3 target = cameraPos + viewForward * 100.0f;
+	Vector3 target = position + viewForward * 100.0f;
 	// owner's up vector needs to be transformed too
-	Vector3 up = Vector3::Transform(Vector3::UnitZ, q);;
-	
-	// create look at matrix, set as view
-	Matrix4 view = Matrix4::CreateLookAt(cameraPos, target, up);
-	SetViewMatrix(view);
+	Vector3 up = Vector3::Transform(Vector3::UnitZ, q);
+
+	// create look at matrix
+	return Matrix4::CreateLookAt(position, target, up);
 }
@@ -1,13 +1,18 @@
 #pragma once
 
 #include "CameraComponent.hpp"
+#include "ComponentPool.hpp"
 
 class FPSCamera : public CameraComponent {
+	DECLARE_POOLED_COMPONENT(FPSCamera, 200)
+	DECLARE_COMPONENT_TYPE(FPSCamera, CameraComponent)
+
 public:
 	FPSCamera(class Actor* owner);  // don't need updateOrder argument here, can just use CameraComponent's default arg value
 	~FPSCamera();
 
 	void Update(float deltaTime) override;
+	void UpdateRenderView(float alpha) override;
 
 	float GetPitch() const {
 		return mPitch;
@@ -36,4 +41,9 @@ private:
 	float mMaxPitch;
 	// current (absolute) pitch
 	float mPitch;
+	// pitch at the start of the current simulation step (for render interpolation)
+	float mPrevPitch;
+
+	// build a first-person view matrix at the given position/orientation
+	Matrix4 ComputeView(const Vector3& position, const Quaternion& rotation, float pitch) const;
 };
\ No newline at end of file
@@ -13,17 +13,44 @@
 #include "SpriteComponent.hpp"
 #include "AudioComponent.hpp"
 #include "FPSActor.hpp"
+#include "CameraComponent.hpp"
+#include "TransformStore.hpp"
+#include "InputDispatcher.hpp"
+#include "ComponentPool.hpp"
+#include "WorkerPool.hpp"
+#include "FrameAllocator.hpp"
+#include "Profiler.hpp"
+#include "Random.hpp"
+#include "Counters.hpp"
+#include "TaskGraph.hpp"
+#include "MemoryTracker.hpp"
+#include <thread>
 
 Game::Game() {
     mIsRunning = true;
+    mHeadless = false;
     mUpdatingActors = false;
-    mTicksCount = 0;
+    mFrameStartCounter = 0;
+    mCounterFrequency = 1;
+    mAccumulator = 0.0f;
+    mTargetFrameTime = 1.0f / 60.0f;
     mRenderer = nullptr;
     mAudioSystem = nullptr;
+    mRecorder = nullptr;
+    mReplayer = nullptr;
+    mTransformStore = new TransformStore();
+    mInputDispatcher = new InputDispatcher();
+    mParallelUpdate = true;
+    mWorkers = nullptr;
+    mFrameGraph = nullptr;
+    mFrameTime = 0.0f;
 }
 
-bool Game::Initialize() {
-    int sdlResult = SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO);
+bool Game::Initialize(bool headless) {
+    mHeadless = headless;
+
+    // headless only needs SDL for timing and logging
+    int sdlResult = SDL_Init(mHeadless ? 0 : SDL_INIT_VIDEO | SDL_INIT_AUDIO);
     if (sdlResult != 0) {
         SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
         return false;
@@ -31,7 +58,7 @@ bool Game::Initialize() {
 
     // create the renderer
     mRenderer = new Renderer(this);
-    if (!mRenderer->Initialize(1024.0f, 768.0f)) {
+    if (!mRenderer->Initialize(1024.0f, 768.0f, mHeadless)) {
         SDL_Log("Failed to initialize renderer");
         mRenderer->Shutdown();
         delete mRenderer;
@@ -41,7 +68,7 @@ bool Game::Initialize() {
 
     // create the audio system
     mAudioSystem = new AudioSystem(this);
-    if (!mAudioSystem->Initialize()) {
+    if (!mAudioSystem->Initialize(mHeadless)) {
         SDL_Log("Failed to initialize audio system");
         mAudioSystem->Shutdown();
         delete mAudioSystem;
@@ -49,23 +76,177 @@ bool Game::Initialize() {
         return false;
     }
 
+    // pace rendering to the display refresh rate (the simulation step is fixed regardless)
+    SDL_DisplayMode mode;
+    if (!mHeadless && SDL_GetCurrentDisplayMode(0, &mode) == 0 && mode.refresh_rate > 0) {
+        mTargetFrameTime = 1.0f / static_cast<float>(mode.refresh_rate);
+    }
+
+    // seed the random generator (with the recorded seed when replaying, so the session plays out the same)
+    Random::Init();
+    if (!mReplayFile.empty()) {
+        mReplayer = new InputReplayer();
+        if (!mReplayer->Open(mReplayFile)) {
+            return false;
+        }
+        Random::Seed(mReplayer->GetSeed());
+    }
+    if (!mRecordFile.empty()) {
+        mRecorder = new InputRecorder();
+        if (!mRecorder->Open(mRecordFile, Random::GetSeed())) {
+            return false;
+        }
+        SDL_Log("Recording input to %s", mRecordFile.c_str());
+    }
+
+    // start the worker threads, with a command buffer for each thread (including this one)
+    mWorkers = new WorkerPool();
+    mCommandBuffers.resize(mWorkers->GetNumThreads());
+    SDL_Log("Updating actors on %zu threads", mWorkers->GetNumThreads());
+    BuildFrameGraph();
+
     LoadData();
 
-    mTicksCount = SDL_GetTicks();
+    // everything created by LoadData that has nothing to update goes to sleep
+    for (auto actor : mActors) {
+        mDormancyChecks.emplace_back(actor->GetHandle());
+    }
+    UpdateDormancy();
+    FlushComponentIndex();
+
+    // the first frame may be drawn before any simulation step runs, so make sure every
+    // actor already has a valid transform to draw with
+    mTransformStore->ComputeWorldTransforms();
+
+    mCounterFrequency = SDL_GetPerformanceFrequency();
+    mFrameStartCounter = SDL_GetPerformanceCounter();
+
+    MemoryTracker::SetReportInterval(MemoryReportFrames);
 
     return true;
 }
 
 void Game::RunLoop() {
     while (mIsRunning) {
+        PROFILE_FRAME();
+        // release last frame's scratch memory
+        FrameAllocator::ResetAll();
+        // close out last frame's memory churn and counters
+        MemoryTracker::EndFrame();
+        Counters::EndFrame();
+
         ProcessInput();
         UpdateGame();
-        GenerateOutput();
+        mFrameGraph->Run(mParallelUpdate);
+    }
+}
+
+void Game::RunHeadless(uint32_t numFrames) {
+    // per-frame times, so we can report more than the average
+    std::vector<double> frameTimes;
+    frameTimes.reserve(numFrames);
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (uint32_t frame = 0; frame < numFrames; ++frame) {
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+
+        PROFILE_FRAME();
+        FrameAllocator::ResetAll();
+        MemoryTracker::EndFrame();
+        Counters::EndFrame();
+
+        // same as ProcessInput, but the keys come from the script
+        mFrameInput.mEvents.clear();
+        GetScriptedInput(frame, mFrameInput.mKeyState);
+        mFrameInput.mMouseX = 0;
+        mFrameInput.mMouseY = 0;
+        ApplyInput(mFrameInput);
+
+        // exactly one fixed step per frame, as fast as possible
+        mFrameTime = FixedDeltaTime;
+        mFrameGraph->Run(mParallelUpdate);
+
+        frameTimes.emplace_back(static_cast<double>(SDL_GetPerformanceCounter() - frameStart) / mCounterFrequency);
     }
+    double total = static_cast<double>(SDL_GetPerformanceCounter() - start) / mCounterFrequency;
+
+    LogFrameTimes("Headless", frameTimes, total);
+}
+
+void Game::RunReplay() {
+    if (mReplayer == nullptr) {
+        SDL_Log("No recording to replay");
+        return;
+    }
+
+    std::vector<double> frameTimes;
+
+    // same frames as the recorded session (input, frame time and so number of steps), but without waiting
+    Uint64 start = SDL_GetPerformanceCounter();
+    while (mIsRunning && mReplayer->ReadFrame(mFrameInput)) {
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+
+        PROFILE_FRAME();
+        FrameAllocator::ResetAll();
+        MemoryTracker::EndFrame();
+        Counters::EndFrame();
+
+        ApplyInput(mFrameInput);
+        mFrameTime = mFrameInput.mFrameTime;
+        mFrameGraph->Run(mParallelUpdate);
+
+        frameTimes.emplace_back(static_cast<double>(SDL_GetPerformanceCounter() - frameStart) / mCounterFrequency);
+    }
+    double total = static_cast<double>(SDL_GetPerformanceCounter() - start) / mCounterFrequency;
+
+    LogFrameTimes("Replay", frameTimes, total);
+}
+
+void Game::LogFrameTimes(const char* label, std::vector<double>& frameTimes, double total) {
+    if (frameTimes.empty()) {
+        return;
+    }
+
+    // report timing
+    std::sort(frameTimes.begin(), frameTimes.end());
+    double average = total / frameTimes.size();
+    double median = frameTimes[frameTimes.size() / 2];
+    double p99 = frameTimes[(frameTimes.size() - 1) * 99 / 100];
+    SDL_Log("%s: %zu frames, %zu actors, %.3f s total (%.1f frames/s)",
+        label, frameTimes.size(), mActors.size(), total, frameTimes.size() / total);
+    SDL_Log("Frame time (ms): avg %.4f, min %.4f, median %.4f, p99 %.4f, max %.4f",
+        average * 1000.0, frameTimes.front() * 1000.0, median * 1000.0, p99 * 1000.0, frameTimes.back() * 1000.0);
+    Counters::LogSummary();
+}
+
+void Game::GetScriptedInput(uint32_t frame, Uint8* keyState) const {
+    memset(keyState, 0, SDL_NUM_SCANCODES);
+
+    // walk a loop around the level: forward, strafe right, back, strafe left (one second each at 60 steps/s)
+    const SDL_Scancode script[] = { SDL_SCANCODE_W, SDL_SCANCODE_D, SDL_SCANCODE_S, SDL_SCANCODE_A };
+    const uint32_t framesPerKey = 60;
+    keyState[script[(frame / framesPerKey) % 4]] = 1;
 }
 
 void Game::ShutDown() {
     UnloadData();
+
+    // finishes the recording file
+    delete mRecorder;
+    mRecorder = nullptr;
+    delete mReplayer;
+    mReplayer = nullptr;
+
+    // every actor is gone, so their transforms are too
+    delete mTransformStore;
+    mTransformStore = nullptr;
+    delete mInputDispatcher;
+    mInputDispatcher = nullptr;
+
+    delete mFrameGraph;
+    mFrameGraph = nullptr;
+    delete mWorkers;
+    mWorkers = nullptr;
     
     if (mRenderer) {
         mRenderer->Shutdown();
@@ -75,39 +256,210 @@ void Game::ShutDown() {
         mAudioSystem->Shutdown();
     }
 
+    // anything still live outside Untagged now is a leak
+    MemoryTracker::LogReport();
+
     SDL_Quit();
 }
 
-void Game::AddActor(Actor* actor) {
-    // if updating actors, need to add to pending so that we don't mess up the iteration over mActors vector
-    if (mUpdatingActors) {
-        mPendingActors.emplace_back(actor);
+ActorHandle Game::AddActor(Actor* actor) {
+    // grab a free slot (or make a new one)
+    uint32_t slotIndex = 0;
+    if (!mFreeActorSlots.empty()) {
+        slotIndex = mFreeActorSlots.back();
+        mFreeActorSlots.pop_back();
     }
     else {
-        mActors.emplace_back(actor);
+        slotIndex = static_cast<uint32_t>(mActorSlots.size());
+        ActorSlot newSlot;
+        newSlot.mActor = nullptr;
+        newSlot.mGeneration = 1;
+        newSlot.mDenseIndex = 0;
+        newSlot.mList = EActiveList;
+        newSlot.mComponentMask = 0;
+        mActorSlots.emplace_back(newSlot);
     }
+
+    ActorSlot& slot = mActorSlots[slotIndex];
+    slot.mActor = actor;
+
+    // if updating actors, need to add to pending so that we don't mess up the iteration over mActors vector
+    AttachActor(slot, mUpdatingActors ? EPendingList : EActiveList);
+
+    return ActorHandle(slotIndex, slot.mGeneration);
 }
 
 void Game::RemoveActor(Actor* actor) {
-    // is it in pending actors?
-    auto iter = std::find(mPendingActors.begin(), mPendingActors.end(), actor);
-    if (iter != mPendingActors.end()) {
-        // swap to end of vector and pop off (avoid erase copies)
-        std::iter_swap(iter, mPendingActors.end() - 1);
-        mPendingActors.pop_back();
+    ActorHandle handle = actor->GetHandle();
+    if (GetActor(handle) != actor) {
+        return;
+    }
+
+    ActorSlot& slot = mActorSlots[handle.mIndex];
+    DetachActor(slot);
+    SetSlotComponentMask(handle.mIndex, 0);
+
+    // free the slot, and invalidate every outstanding handle to it
+    slot.mActor = nullptr;
+    slot.mGeneration += 1;
+    mFreeActorSlots.emplace_back(handle.mIndex);
+}
+
+void Game::QueueDormancyCheck(Actor* actor) {
+    mDormancyChecks.emplace_back(actor->GetHandle());
+}
+
+void Game::WakeActor(Actor* actor) {
+    ActorSlot& slot = mActorSlots[actor->GetHandle().mIndex];
+    if (slot.mList != EDormantList) {
         return;
     }
 
-    // is it in actors?
-    iter = std::find(mActors.begin(), mActors.end(), actor);
-    if (iter != mActors.end()) {
-        // swap to end of vector and pop off (avoid erase copies)
-        std::iter_swap(iter, mActors.end() - 1);
-        mActors.pop_back();
+    // taking it out of the dormant list is always safe, but it can only join mActors when nobody is iterating it
+    DetachActor(slot);
+    AttachActor(slot, mUpdatingActors ? EPendingList : EActiveList);
+    actor->mDormant = false;
+}
+
+void Game::UpdateDormancy() {
+    for (ActorHandle handle : mDormancyChecks) {
+        Actor* actor = GetActor(handle);
+        if (actor == nullptr || actor->GetState() == Actor::EDead) {
+            continue;
+        }
+
+        ActorSlot& slot = mActorSlots[handle.mIndex];
+        if (slot.mList == EActiveList && (actor->IsStatic() || !actor->NeedsUpdate())) {
+            DetachActor(slot);
+            AttachActor(slot, EDormantList);
+            actor->mDormant = true;
+        }
+    }
+    mDormancyChecks.clear();
+}
+
+std::vector<Actor*>& Game::GetActorList(ActorList list) {
+    if (list == EPendingList) {
+        return mPendingActors;
+    }
+    if (list == EDormantList) {
+        return mDormantActors;
+    }
+    return mActors;
+}
+
+void Game::DetachActor(ActorSlot& slot) {
+    std::vector<Actor*>& actors = GetActorList(slot.mList);
+
+    // swap to end of vector and pop off (avoid erase copies), fixing up the moved actor's slot
+    Actor* last = actors.back();
+    actors[slot.mDenseIndex] = last;
+    mActorSlots[last->GetHandle().mIndex].mDenseIndex = slot.mDenseIndex;
+    actors.pop_back();
+}
+
+void Game::AttachActor(ActorSlot& slot, ActorList list) {
+    std::vector<Actor*>& actors = GetActorList(list);
+    slot.mList = list;
+    slot.mDenseIndex = static_cast<uint32_t>(actors.size());
+    actors.emplace_back(slot.mActor);
+}
+
+void Game::QueueComponentIndex(Actor* actor) {
+    ActorHandle handle = actor->GetHandle();
+    // a worker (updating its actor in parallel) can't touch the shared queue, so its entry goes through
+    // the thread's command buffer and is queued at the sync point
+    if (WorkerPool::GetThreadIndex() != 0) {
+        GetCommandBuffer().Run([this, handle]() {
+            mComponentIndexQueue.emplace_back(handle);
+        });
+        return;
+    }
+    mComponentIndexQueue.emplace_back(handle);
+}
+
+void Game::FlushComponentIndex() {
+    for (ActorHandle handle : mComponentIndexQueue) {
+        Actor* actor = GetActor(handle);
+        if (actor != nullptr) {
+            // also rebuilds the actor's own lookup table, so it's read-only during the parallel update
+            SetSlotComponentMask(handle.mIndex, actor->GetComponentMask());
+        }
+    }
+    mComponentIndexQueue.clear();
+}
+
+void Game::SetSlotComponentMask(uint32_t slotIndex, uint64_t typeMask) {
+    ActorSlot& slot = mActorSlots[slotIndex];
+    uint64_t changed = slot.mComponentMask ^ typeMask;
+    slot.mComponentMask = typeMask;
+
+    size_t word = slotIndex / 64;
+    uint64_t slotBit = 1ull << (slotIndex % 64);
+    for (uint32_t type = 0; changed != 0; ++type, changed >>= 1) {
+        if ((changed & 1) == 0) {
+            continue;
+        }
+
+        std::vector<uint64_t>& actors = mComponentTypeActors[type];
+        if (actors.size() <= word) {
+            actors.resize(word + 1, 0);
+        }
+        actors[word] ^= slotBit;
+    }
+}
+
+void Game::GetActorsWithMask(uint64_t typeMask, std::vector<Actor*>& outActors) {
+    outActors.clear();
+    if (typeMask == 0) {
+        return;
+    }
+
+    // components only change on the main thread outside of the parallel update, so the queue is
+    // always empty while actors are updating
+    if (!mUpdatingActors) {
+        FlushComponentIndex();
+    }
+
+    // only slots that are in every requested bitset
+    size_t numWords = (mActorSlots.size() + 63) / 64;
+    for (size_t word = 0; word < numWords; ++word) {
+        uint64_t bits = ~0ull;
+        uint64_t types = typeMask;
+        for (uint32_t type = 0; types != 0 && bits != 0; ++type, types >>= 1) {
+            if (types & 1) {
+                const std::vector<uint64_t>& actors = mComponentTypeActors[type];
+                bits &= word < actors.size() ? actors[word] : 0;
+            }
+        }
+
+        while (bits != 0) {
+            uint32_t bit = CountBits((bits & (0 - bits)) - 1);
+            outActors.emplace_back(mActorSlots[word * 64 + bit].mActor);
+            bits &= bits - 1;
+        }
+    }
+}
+
+CommandBuffer& Game::GetCommandBuffer() {
+    return mCommandBuffers[WorkerPool::GetThreadIndex()];
+}
+
+Actor* Game::GetActor(ActorHandle handle) const {
+    if (handle.mIndex >= mActorSlots.size()) {
+        return nullptr;
+    }
+
+    const ActorSlot& slot = mActorSlots[handle.mIndex];
+    if (slot.mGeneration != handle.mGeneration) {
+        return nullptr;
     }
+    return slot.mActor;
 }
 
 void Game::LoadData() {
+    MEMORY_TAG_SCOPE(EActors);
+
     // create actors
     Actor* a = new Actor(this);
     a->SetPosition(Vector3(200.0f, 75.0f, 0.0f));
@@ -190,10 +542,12 @@ void Game::LoadData() {
     mMusicEvent = mAudioSystem->PlayEvent("event:/Music");
 
     // FPS Camera ===================================================
-    // enable relative mouse mode for camera look
-    SDL_SetRelativeMouseMode(SDL_TRUE);
-    // make an initial call to get relative data to clear out
-    SDL_GetRelativeMouseState(nullptr, nullptr);
+    if (!mHeadless) {
+        // enable relative mouse mode for camera look
+        SDL_SetRelativeMouseMode(SDL_TRUE);
+        // make an initial call to get relative data to clear out
+        SDL_GetRelativeMouseState(nullptr, nullptr);
+    }
 
     // different camera actors
     mFPSActor = new FPSActor(this);
@@ -206,6 +560,12 @@ void Game::UnloadData() {
     while (!mActors.empty()) {
         delete mActors.back();
     }
+    while (!mPendingActors.empty()) {
+        delete mPendingActors.back();
+    }
+    while (!mDormantActors.empty()) {
+        delete mDormantActors.back();
+    }
 
     if (mRenderer) {
         mRenderer->UnloadData();
@@ -213,8 +573,25 @@ void Game::UnloadData() {
 }
 
 void Game::ProcessInput() {
+    PROFILE_SCOPE("Game::ProcessInput");
+
+    // gather this frame's input in one place, so it can be recorded
+    mFrameInput.mEvents.clear();
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
+        mFrameInput.mEvents.emplace_back(event);
+    }
+
+    memcpy(mFrameInput.mKeyState, SDL_GetKeyboardState(NULL), SDL_NUM_SCANCODES);
+
+    // relative mouse motion since last frame (read once here, so every listener sees the same motion)
+    SDL_GetRelativeMouseState(&mFrameInput.mMouseX, &mFrameInput.mMouseY);
+
+    ApplyInput(mFrameInput);
+}
+
+void Game::ApplyInput(const FrameInput& input) {
+    for (const auto& event : input.mEvents) {
         switch (event.type) {
         case SDL_QUIT:
             mIsRunning = false;
@@ -230,16 +607,13 @@ void Game::ProcessInput() {
         }
     }
 
-    const Uint8* state = SDL_GetKeyboardState(NULL);
-    if (state[SDL_SCANCODE_ESCAPE]) {
+    if (input.mKeyState[SDL_SCANCODE_ESCAPE]) {
         mIsRunning = false;
     }
 
-    // loop over all actors and call ProcessInput() on each one
+    // only the actors that subscribed to a key/the mouse that changed get ProcessInput() called
     mUpdatingActors = true;
-    for (auto actor : mActors) {
-        actor->ProcessInput(state);
-    }
+    mInputDispatcher->Dispatch(input.mKeyState, input.mMouseX, input.mMouseY);
     mUpdatingActors = false;
 }
 
@@ -259,58 +633,276 @@ void Game::HandleKeyPress(int key) {
         volume = Math::Min(1.0f, volume + 0.1f);
         mAudioSystem->SetBusVolume("bus:/", volume);
         break;
+    case 'm':
+        // memory by tag
+        MemoryTracker::LogReport();
+        break;
+    case 'c':
+        // dump the counter history
+        Counters::LogSummary();
+        mFrameGraph->LogTimings();
+        if (Counters::WriteCSV("counters.csv")) {
+            SDL_Log("Wrote %u frames of counters to counters.csv", Counters::GetNumFrames());
+        }
+        else {
+            SDL_Log("Failed to write counters.csv");
+        }
+        break;
+#ifdef ENABLE_PROFILER
+    case 'p':
+    {
+        // dump the last few seconds of frames
+        uint32_t lastFrame = Profiler::GetFrame();
+        uint32_t firstFrame = lastFrame > ProfileCaptureFrames ? lastFrame - ProfileCaptureFrames : 0;
+        if (Profiler::WriteChromeTrace("profile.json", firstFrame, lastFrame)) {
+            SDL_Log("Wrote frames %u-%u to profile.json", firstFrame, lastFrame);
+        }
+        else {
+            SDL_Log("Failed to write profile.json");
+        }
+        break;
+    }
+#endif
     default:
         break;
     }
 }
 
 void Game::UpdateGame() {
+    PROFILE_SCOPE("Game::UpdateGame");
+
     // frame limiting
-    // wait until 16ms has elapsed since last frame
-    while (!SDL_TICKS_PASSED(SDL_GetTicks(), mTicksCount + 16)) {
+    // sleep until the target frame time has elapsed, instead of spinning on the CPU
+    WaitForNextFrame();
+
+    // compute real time elapsed since last frame
+    Uint64 now = SDL_GetPerformanceCounter();
+    float frameTime = static_cast<float>(now - mFrameStartCounter) / static_cast<float>(mCounterFrequency);
+    mFrameStartCounter = now;
+
+    // the frame time decides how many steps run, so it's part of the recording
+    if (mRecorder != nullptr) {
+        mFrameInput.mFrameTime = frameTime;
+        mRecorder->RecordFrame(mFrameInput);
+    }
+
+    // simulated by the frame graph
+    mFrameTime = frameTime;
+}
+
+void Game::AdvanceFrame(float frameTime) {
+    // clamp so a long stall (eg breakpoint, window drag) doesn't force a huge catch-up
+    if (frameTime > MaxFrameTime) {
+        frameTime = MaxFrameTime;
+    }
+    // audio runs once per rendered frame, on the same (clamped) time
+    mFrameTime = frameTime;
+
+    // run as many fixed simulation steps as the elapsed time allows; any remainder is carried over
+    // to the next frame and used to interpolate between the last two simulation states when drawing
+    mAccumulator += frameTime;
+    while (mAccumulator >= FixedDeltaTime) {
+        StepSimulation(FixedDeltaTime);
+        mAccumulator -= FixedDeltaTime;
+    }
+}
+
+void Game::BuildFrameGraph() {
+    // everything after input: the simulation, then audio alongside preparing and drawing the frame
+    // (the simulation uses the WorkerPool and drawing makes GL calls, so those stay on this thread)
+    mFrameGraph = new TaskGraph();
+    TaskGraph::TaskId simulate = mFrameGraph->AddTask("Simulation", [this]() {
+        AdvanceFrame(mFrameTime);
+    }, {}, TaskGraph::EMainThread);
+    mFrameGraph->AddTask("Audio", [this]() {
+        mAudioSystem->Update(mFrameTime);
+    }, { simulate });
+    TaskGraph::TaskId prepare = mFrameGraph->AddTask("PrepareOutput", [this]() {
+        PrepareOutput();
+    }, { simulate });
+    mFrameGraph->AddTask("Draw", [this]() {
+        mRenderer->Draw();
+    }, { prepare }, TaskGraph::EMainThread);
+}
+
+void Game::UpdateActors(const std::vector<Actor*>& actors, float deltaTime, int beginOrder, int endOrder,
+    WorkerPool* workers) {
+    if (actors.empty()) {
+        return;
+    }
+
+    if (workers) {
+        workers->ParallelFor(actors.size(), ActorBatchSize, [&actors, deltaTime, beginOrder, endOrder](size_t begin, size_t end) {
+            PROFILE_SCOPE("Actor::Update batch");
+            for (size_t i = begin; i < end; ++i) {
+                actors[i]->Update(deltaTime, beginOrder, endOrder);
+            }
+        });
+    }
+    else {
+        PROFILE_SCOPE("Actor::Update");
+        for (auto actor : actors) {
+            actor->Update(deltaTime, beginOrder, endOrder);
+        }
+    }
+}
+
+void Game::CollectPhaseActors() {
+    PROFILE_SCOPE("Game::CollectPhaseActors");
+
+    // pools sharing an update order make one phase
+    mPhaseEnds.clear();
+    for (ComponentPoolBase* pool : ComponentPoolBase::GetPools()) {
+        if (mPhaseEnds.empty() || mPhaseEnds.back() != pool->GetUpdateOrder()) {
+            mPhaseEnds.emplace_back(pool->GetUpdateOrder());
+        }
+    }
+    if (mPhaseActors.size() < mPhaseEnds.size()) {
+        mPhaseActors.resize(mPhaseEnds.size());
+    }
+    for (auto& actors : mPhaseActors) {
+        actors.clear();
+    }
+    if (mPhaseEnds.empty()) {
+        return;
     }
 
-    // compute delta time
-    float deltaTime = (SDL_GetTicks() - mTicksCount) / 1000.0f;
-    if (deltaTime > 0.05f) {
-        deltaTime = 0.05f;
+    // components are sorted by update order, so each actor only walks the ones before the last pool
+    // (everything from there on is covered by the final pass over every actor)
+    int lastOrder = mPhaseEnds.back();
+    for (auto actor : mActors) {
+        if (actor->GetState() != Actor::EActive) {
+            continue;
+        }
+
+        size_t phase = 0;
+        for (auto comp : actor->mComponents) {
+            int order = comp->GetUpdateOrder();
+            if (order >= lastOrder) {
+                break;
+            }
+            if (comp->IsPooled()) {
+                continue;
+            }
+
+            while (order >= mPhaseEnds[phase]) {
+                phase += 1;
+            }
+            std::vector<Actor*>& actors = mPhaseActors[phase];
+            if (actors.empty() || actors.back() != actor) {
+                actors.emplace_back(actor);
+            }
+        }
     }
+}
+
+void Game::StepSimulation(float deltaTime) {
+    PROFILE_SCOPE("Game::StepSimulation");
 
-    mTicksCount = SDL_GetTicks();
+    // remember where every actor was at the start of this step, for render interpolation
+    mTransformStore->SaveState();
 
     // update all actors
+    COUNTER_ADD("ActorsUpdated", static_cast<int64_t>(mActors.size()));
     mUpdatingActors = true;
-    for (auto actor : mActors) {
-        actor->Update(deltaTime);
+    WorkerPool* workers = mParallelUpdate ? mWorkers : nullptr;
+    // each pooled type updates in one go at its update order, the actors' other components
+    // update in phases between the pools, so update order holds across pooled and non-pooled components
+    // (a phase only visits the actors with a non-pooled component in it)
+    CollectPhaseActors();
+    int beginOrder = INT_MIN;
+    for (size_t phase = 0; phase < mPhaseEnds.size(); ++phase) {
+        int endOrder = mPhaseEnds[phase];
+        UpdateActors(mPhaseActors[phase], deltaTime, beginOrder, endOrder, workers);
+        // by index and matched by order, since a component type allocated for the first time during
+        // the update inserts its pool into the list
+        const std::vector<ComponentPoolBase*>& pools = ComponentPoolBase::GetPools();
+        for (size_t i = 0; i < pools.size(); ++i) {
+            if (pools[i]->GetUpdateOrder() == endOrder) {
+                pools[i]->UpdateAll(deltaTime, workers);
+            }
+        }
+        beginOrder = endOrder;
+    }
+    // then the components after the last pool, and each actor's own update
+    UpdateActors(mActors, deltaTime, beginOrder, INT_MAX, workers);
+
+    // sync point: apply everything the actors deferred (new actors still go to pending here)
+    {
+        PROFILE_SCOPE("CommandBuffer::Execute");
+        for (auto& buffer : mCommandBuffers) {
+            buffer.Execute(this);
+        }
     }
     mUpdatingActors = false;
 
-    // move any pending actors to mActors
+    // move any pending actors to mActors (new ones may be able to sleep right away)
     for (auto pending : mPendingActors) {
-        // make sure any actors created while updating other actors have their world transform 
-        // calculated in the same frame where they are created
-        pending->ComputeWorldTransform();
-        mActors.emplace_back(pending);
+        AttachActor(mActorSlots[pending->GetHandle().mIndex], EActiveList);
+        mDormancyChecks.emplace_back(pending->GetHandle());
     }
     mPendingActors.clear();
 
-    // add any dead actors to a temp vector
-    std::vector<Actor*> deadActors;
-    for (auto actor : mActors) {
-        if (actor->GetState() == Actor::EDead) {
-            deadActors.emplace_back(actor);
-        }
+    // index the components of new actors (and any added/removed this step) before anyone looks them up
+    FlushComponentIndex();
+
+    // rebuild the world transforms of everything that moved (including actors created this step)
+    // in one pass, instead of per actor
+    {
+        PROFILE_SCOPE("TransformStore::ComputeWorldTransforms");
+        mTransformStore->ComputeWorldTransforms();
     }
 
-    // delete dead actors (which removes them from mActors)
-    for (auto actor : deadActors) {
-        delete actor;
+    // delete dead actors in one backward sweep (no temp vector)
+    // deleting swaps the last actor into the freed index; everything past i has already been checked,
+    // so the swapped-in actor is alive and the sweep just moves on
+    size_t i = mActors.size();
+    while (i > 0) {
+        i -= 1;
+        // a destructor may delete other actors too, so re-check the bounds
+        if (i < mActors.size() && mActors[i]->GetState() == Actor::EDead) {
+            delete mActors[i];
+        }
     }
 
-    // update audio system
-    mAudioSystem->Update(deltaTime);
+    // put anything that has nothing to do to sleep
+    UpdateDormancy();
 }
 
-void Game::GenerateOutput() {
-    mRenderer->Draw();
+void Game::WaitForNextFrame() {
+    PROFILE_SCOPE("Game::WaitForNextFrame");
+
+    const Uint64 frameEnd = mFrameStartCounter + static_cast<Uint64>(mTargetFrameTime * mCounterFrequency);
+
+    while (true) {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (now >= frameEnd) {
+            break;
+        }
+
+        float remaining = static_cast<float>(frameEnd - now) / static_cast<float>(mCounterFrequency);
+        if (remaining > SleepMargin) {
+            // sleep for the bulk of the wait, leaving a margin for the OS scheduler's granularity
+            SDL_Delay(static_cast<Uint32>((remaining - SleepMargin) * 1000.0f));
+        }
+        else {
+            // close to the deadline, give up the rest of our time slice rather than oversleeping
+            std::this_thread::yield();
+        }
+    }
+}
+
+void Game::PrepareOutput() {
+    PROFILE_SCOPE("Game::PrepareOutput");
+
+    // how far we are between the previous and current simulation states
+    float alpha = mAccumulator / FixedDeltaTime;
+
+    mTransformStore->ComputeRenderTransforms(alpha);
+
+    // the camera follows the interpolated transforms so the view doesn't lag behind the meshes
+    CameraComponent* camera = mRenderer->GetCamera();
+    if (camera) {
+        camera->UpdateRenderView(alpha);
+    }
 }
@@ -2,18 +2,58 @@
 
 #include <vector>
 #include "SoundEvent.hpp"
+#include "ActorHandle.hpp"
+#include "CommandBuffer.hpp"
+#include "Component.hpp"
+#include "InputRecording.hpp"
+#include <string>
 #include "SDL/SDL.h"
 
 class Game {
 public:
     Game();
 
-    bool Initialize();
+    // headless = no window, GL or FMOD (null renderer/audio), for running the simulation on build machines
+    bool Initialize(bool headless = false);
     void RunLoop();
+    // run numFrames frames back to back with scripted input (instead of RunLoop), then log timing
+    void RunHeadless(uint32_t numFrames);
+    // play the recording set with SetReplay back as fast as possible (instead of RunLoop), then log timing
+    void RunReplay();
+    // record every frame's input, frame time and the random seed to a file (call before Initialize)
+    void SetRecording(const std::string& fileName) {
+        mRecordFile = fileName;
+    }
+    // take input, frame times and the random seed from a recording (call before Initialize)
+    void SetReplay(const std::string& fileName) {
+        mReplayFile = fileName;
+    }
     void ShutDown();
 
-    void AddActor(class Actor* actor);
+    // returns the actor's handle
+    ActorHandle AddActor(class Actor* actor);
     void RemoveActor(class Actor* actor);
+    // returns nullptr if the actor has been deleted
+    class Actor* GetActor(ActorHandle handle) const;
+
+    // every live actor (active, pending or dormant) with a component of each listed type,
+    // found through per-type actor bitsets instead of visiting every actor
+    // e.g. GetActorsWith<MoveComponent, CircleComponent>(actors)
+    template<typename... Ts>
+    void GetActorsWith(std::vector<class Actor*>& outActors) {
+        GetActorsWithMask(ComponentTypeBits<Ts...>(), outActors);
+    }
+    void GetActorsWithMask(uint64_t typeMask, std::vector<class Actor*>& outActors);
+    // have Game re-read the actor's component types (called by Actor when components are added/removed;
+    // from a worker thread the request is deferred through its command buffer)
+    void QueueComponentIndex(class Actor* actor);
+
+    // dormant actors (static, or nothing to update) live in their own list and are skipped by the
+    // per-frame input/update loops
+    // have Game decide at the end of the step whether the actor should be dormant
+    void QueueDormancyCheck(class Actor* actor);
+    // bring a dormant actor back into the update loops (called by Actor when its transform/state changes)
+    void WakeActor(class Actor* actor);
 
     class Renderer* GetRenderer() const {
         return mRenderer;
@@ -23,24 +63,123 @@ public:
         return mAudioSystem;
     }
 
+    class TransformStore* GetTransformStore() const {
+        return mTransformStore;
+    }
+
+    class InputDispatcher* GetInputDispatcher() const {
+        return mInputDispatcher;
+    }
+
+    // command buffer of the calling thread
+    // anything an actor does during its update that touches something other than itself
+    // (creating/killing actors, moving other actors, setting renderer/audio state) must go through here
+    CommandBuffer& GetCommandBuffer();
+
+    // update actors and pooled components across all cores (and overlap the frame graph tasks)
+    void SetParallelUpdate(bool parallel) {
+        mParallelUpdate = parallel;
+    }
+    bool GetParallelUpdate() const {
+        return mParallelUpdate;
+    }
+
 private:
     void ProcessInput();
+    // react to one frame's input (live, scripted or replayed)
+    void ApplyInput(const FrameInput& input);
     void HandleKeyPress(int key);
     void UpdateGame();
-    void GenerateOutput();
+    // run the fixed steps covered by frameTime
+    void AdvanceFrame(float frameTime);
+    // set up mFrameGraph (once, in Initialize)
+    void BuildFrameGraph();
+    // log the distribution of a run's frame times (sorts frameTimes)
+    void LogFrameTimes(const char* label, std::vector<double>& frameTimes, double total);
+    // interpolated transforms and view for Renderer::Draw
+    void PrepareOutput();
+
+    // advance the simulation by a single fixed step
+    void StepSimulation(float deltaTime);
+    // update the actors' components in [beginOrder, endOrder) (and the actors themselves once endOrder is INT_MAX)
+    void UpdateActors(const std::vector<class Actor*>& actors, float deltaTime, int beginOrder, int endOrder,
+        class WorkerPool* workers);
+    // split the step's update into phases at the pools' update orders, and find the actors with a
+    // non-pooled component in each phase before the last pool (fills mPhaseEnds/mPhaseActors)
+    void CollectPhaseActors();
+    // sleep (then yield) until the target frame time has elapsed since the start of the last frame
+    void WaitForNextFrame();
+    // fill in the keyboard state for a headless frame
+    void GetScriptedInput(uint32_t frame, Uint8* keyState) const;
+    // put every actor queued with QueueDormancyCheck that can sleep into mDormantActors
+    void UpdateDormancy();
+    // bring the per-type actor bitsets up to date with every actor queued by QueueComponentIndex
+    void FlushComponentIndex();
     
     void LoadData();
     void UnloadData();
 
 private:
     bool mIsRunning;
-    Uint32 mTicksCount;
+    // running without window/GL/FMOD
+    bool mHeadless;
+
+    // input of the current frame
+    FrameInput mFrameInput;
+    // set when recording/replaying a session
+    std::string mRecordFile;
+    std::string mReplayFile;
+    class InputRecorder* mRecorder;
+    class InputReplayer* mReplayer;
+
+    // high-resolution counter value at the start of the previous frame
+    Uint64 mFrameStartCounter;
+    // counts per second of the high-resolution counter
+    Uint64 mCounterFrequency;
+    // unsimulated time carried over between frames (always less than one fixed step after AdvanceFrame)
+    float mAccumulator;
+    // minimum time between rendered frames (matches the display refresh rate)
+    float mTargetFrameTime;
+
+    // the simulation always advances in steps of this size, independent of the render rate
+    const float FixedDeltaTime = 1.0f / 60.0f;
+    // longest frame we will try to catch up on, so a long stall doesn't snowball into more and more steps
+    const float MaxFrameTime = 0.25f;
+    // remaining wait time below which we stop sleeping and yield instead (sleep granularity is ~1ms)
+    const float SleepMargin = 0.002f;
 
     // track if we are updating actors right now
     bool mUpdatingActors;
 
+    // parallel update
+    bool mParallelUpdate;
+    class WorkerPool* mWorkers;
+    // one per thread of mWorkers, executed in thread order at the end of the actor update
+    std::vector<CommandBuffer> mCommandBuffers;
+    // runs the frame after input (simulation, audio, output) with independent work overlapping
+    class TaskGraph* mFrameGraph;
+    // time the frame graph advances by (set before running it)
+    float mFrameTime;
+    // number of actors each worker grabs at a time
+    const size_t ActorBatchSize = 64;
+    // update order each phase of the actor update ends at (one per distinct pool update order)
+    std::vector<int> mPhaseEnds;
+    // per phase, the active actors with a non-pooled component in it
+    // (kept around to avoid reallocating every step)
+    std::vector<std::vector<class Actor*>> mPhaseActors;
+
+    // frames between memory reports
+    const uint32_t MemoryReportFrames = 600;
+
+    // number of frames written out by the profile capture key
+    const uint32_t ProfileCaptureFrames = 300;
+
     class Renderer* mRenderer;
     class AudioSystem* mAudioSystem;
+    // transforms of every actor
+    class TransformStore* mTransformStore;
+    // sends input to the actors that subscribed to it
+    class InputDispatcher* mInputDispatcher;
 
     // game-specific data
     class FPSActor* mFPSActor;
@@ -52,4 +191,41 @@ private:
     std::vector<class Actor*> mActors;
     // all pending actors
     std::vector<class Actor*> mPendingActors;
+    // actors that don't need input/update right now (never iterated per frame)
+    std::vector<class Actor*> mDormantActors;
+    // actors to consider for dormancy at the end of the step
+    std::vector<ActorHandle> mDormancyChecks;
+
+    // which of the actor vectors an actor is in
+    enum ActorList {
+        EActiveList,
+        EPendingList,
+        EDormantList
+    };
+
+    // slot map of actor handles
+    // each slot points at the actor's position in its actor vector, so removal is a swap and pop
+    struct ActorSlot {
+        class Actor* mActor;  // nullptr if the slot is free
+        uint32_t mGeneration;
+        uint32_t mDenseIndex;  // index into the vector for mList
+        ActorList mList;
+        uint64_t mComponentMask;  // component types the bitsets below currently have this actor under
+    };
+
+    std::vector<class Actor*>& GetActorList(ActorList list);
+    // take an actor out of its current vector (swap and pop)
+    void DetachActor(ActorSlot& slot);
+    // append an actor to a vector
+    void AttachActor(ActorSlot& slot, ActorList list);
+    // move a slot's bits in the per-type bitsets from its old mask to the new one
+    void SetSlotComponentMask(uint32_t slotIndex, uint64_t typeMask);
+
+    // per component type, one bit per actor slot set if that actor has a component of the type
+    std::vector<uint64_t> mComponentTypeActors[Component::MaxTypes];
+    // actors whose components changed since the last FlushComponentIndex
+    std::vector<ActorHandle> mComponentIndexQueue;
+    std::vector<ActorSlot> mActorSlots;
+    // indices of free slots, reused before growing mActorSlots
+    std::vector<uint32_t> mFreeActorSlots;
 };
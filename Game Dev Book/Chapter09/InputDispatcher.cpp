@@ -0,0 +1,146 @@
+#include "InputDispatcher.hpp"
+#include "Profiler.hpp"
+#include "SDL/SDL.h"
+#include <algorithm>
+
+InputDispatcher::InputDispatcher() {
+	for (auto& actions : mKeyActions) {
+		actions = 0;
+	}
+	mMouseX = 0;
+	mMouseY = 0;
+}
+
+uint32_t InputDispatcher::AddAction(const char* name, const KeySet& keys) {
+	if (mActionKeys.size() >= MaxActions) {
+		SDL_Log("Too many input actions, can't add %s", name);
+		return MaxActions - 1;
+	}
+
+	uint32_t action = static_cast<uint32_t>(mActionKeys.size());
+	mActionKeys.emplace_back(keys);
+	for (size_t key = 0; key < SDL_NUM_SCANCODES; ++key) {
+		if (keys[key]) {
+			mKeyActions[key] |= 1ull << action;
+		}
+	}
+	return action;
+}
+
+bool InputDispatcher::IsActionHeld(uint32_t action, const uint8_t* keyState) const {
+	const KeySet& keys = mActionKeys[action];
+	for (size_t key = 0; key < SDL_NUM_SCANCODES; ++key) {
+		if (keys[key] && keyState[key]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void InputDispatcher::Subscribe(InputListener* listener, const KeySet& keys, uint64_t actions, bool mouse) {
+	Subscription sub;
+	sub.mListener = listener;
+	sub.mKeys = keys;
+	sub.mMouse = mouse;
+
+	// fold the actions into the key set, so dispatching only ever tests one bitset
+	for (uint32_t action = 0; action < mActionKeys.size(); ++action) {
+		if (actions & (1ull << action)) {
+			sub.mKeys |= mActionKeys[action];
+		}
+	}
+
+	auto iter = std::find_if(mSubscriptions.begin(), mSubscriptions.end(),
+		[listener](const Subscription& s) { return s.mListener == listener; });
+	if (iter != mSubscriptions.end()) {
+		*iter = sub;
+	}
+	else {
+		mSubscriptions.emplace_back(sub);
+	}
+	RebuildWatchedKeys();
+}
+
+void InputDispatcher::Unsubscribe(InputListener* listener) {
+	auto iter = std::find_if(mSubscriptions.begin(), mSubscriptions.end(),
+		[listener](const Subscription& s) { return s.mListener == listener; });
+	if (iter != mSubscriptions.end()) {
+		mSubscriptions.erase(iter);
+		RebuildWatchedKeys();
+	}
+}
+
+void InputDispatcher::RebuildWatchedKeys() {
+	KeySet watched;
+	for (const auto& sub : mSubscriptions) {
+		watched |= sub.mKeys;
+	}
+
+	mWatchedKeys.clear();
+	for (size_t key = 0; key < SDL_NUM_SCANCODES; ++key) {
+		if (watched[key]) {
+			mWatchedKeys.emplace_back(static_cast<SDL_Scancode>(key));
+		}
+	}
+}
+
+void InputDispatcher::Dispatch(const uint8_t* keyState, int mouseX, int mouseY) {
+	PROFILE_SCOPE("InputDispatcher::Dispatch");
+
+	// queue up this frame's changes
+	mEvents.clear();
+	for (SDL_Scancode key : mWatchedKeys) {
+		bool down = keyState[key] != 0;
+		if (down != mPrevKeys[key]) {
+			InputEvent event;
+			event.mType = down ? InputEvent::EKeyDown : InputEvent::EKeyUp;
+			event.mKey = key;
+			event.mActions = mKeyActions[key];
+			event.mMouseX = 0;
+			event.mMouseY = 0;
+			mEvents.emplace_back(event);
+			mPrevKeys[key] = down;
+		}
+	}
+
+	bool mouseChanged = mouseX != mMouseX || mouseY != mMouseY;
+	mMouseX = mouseX;
+	mMouseY = mouseY;
+	if (mouseChanged) {
+		InputEvent event;
+		event.mType = InputEvent::EMouseMove;
+		event.mKey = SDL_SCANCODE_UNKNOWN;
+		event.mActions = 0;
+		event.mMouseX = mouseX;
+		event.mMouseY = mouseY;
+		mEvents.emplace_back(event);
+	}
+
+	if (mEvents.empty()) {
+		return;
+	}
+
+	// hand every listener its share of the events
+	// (index loop, a listener may subscribe or unsubscribe from its OnInput)
+	for (size_t i = 0; i < mSubscriptions.size(); ++i) {
+		mListenerEvents.clear();
+		for (const auto& event : mEvents) {
+			bool wanted = event.mType == InputEvent::EMouseMove ? mSubscriptions[i].mMouse : mSubscriptions[i].mKeys[event.mKey];
+			if (wanted) {
+				mListenerEvents.emplace_back(event);
+			}
+		}
+
+		if (!mListenerEvents.empty()) {
+			mSubscriptions[i].mListener->OnInput(mListenerEvents.data(), mListenerEvents.size(), keyState);
+		}
+	}
+}
+
+InputDispatcher::KeySet InputDispatcher::MakeKeySet(std::initializer_list<SDL_Scancode> keys) {
+	KeySet set;
+	for (SDL_Scancode key : keys) {
+		set[key] = true;
+	}
+	return set;
+}
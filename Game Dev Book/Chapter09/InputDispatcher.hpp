@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+#include <bitset>
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+#include "SDL/SDL_scancode.h"
+
+// one change in the input this frame
+struct InputEvent {
+	enum Type {
+		EKeyDown,
+		EKeyUp,
+		EMouseMove  // relative mouse motion changed (mMouseX/Y are this frame's motion, can be 0)
+	};
+
+	Type mType;
+	SDL_Scancode mKey;
+	// bit per action (see InputDispatcher::AddAction) this key is bound to
+	uint64_t mActions;
+	int mMouseX;
+	int mMouseY;
+};
+
+// anything that wants input registers with the InputDispatcher
+class InputListener {
+public:
+	virtual ~InputListener() {}
+
+	// called once per frame, only if something the listener subscribed to changed
+	// (events are in the order they were detected, keyState is the full keyboard state)
+	virtual void OnInput(const InputEvent* events, size_t numEvents, const uint8_t* keyState) = 0;
+};
+
+// routes input to the listeners that asked for it, instead of handing the keyboard to every actor
+// - listeners subscribe to a set of keys and/or actions (named groups of keys) and/or mouse motion,
+//   which is turned into one key bitset per listener when subscribing
+// - once per frame, Dispatch compares only the keys somebody listens to against last frame,
+//   queues an event per change, then hands each listener its matching events in one batch
+// so the cost depends on the number of watched keys and listeners, not the number of actors
+class InputDispatcher {
+public:
+	typedef std::bitset<SDL_NUM_SCANCODES> KeySet;
+
+	static const uint32_t MaxActions = 64;
+
+	InputDispatcher();
+
+	// bind a group of keys to a new action, returns the action id (its bit is 1 << id)
+	uint32_t AddAction(const char* name, const KeySet& keys);
+	// is any key of the action held?
+	bool IsActionHeld(uint32_t action, const uint8_t* keyState) const;
+
+	// start sending the listener events for these keys/actions (calling again replaces the subscription)
+	void Subscribe(InputListener* listener, const KeySet& keys, uint64_t actions = 0, bool mouse = false);
+	void Unsubscribe(InputListener* listener);
+
+	// find this frame's changes and deliver them (mouseX/Y is the relative mouse motion this frame)
+	void Dispatch(const uint8_t* keyState, int mouseX, int mouseY);
+
+	// relative mouse motion passed to the last Dispatch
+	void GetMouseDelta(int& x, int& y) const {
+		x = mMouseX;
+		y = mMouseY;
+	}
+
+	// helper to build a key set
+	static KeySet MakeKeySet(std::initializer_list<SDL_Scancode> keys);
+
+private:
+	struct Subscription {
+		InputListener* mListener;
+		KeySet mKeys;  // includes the keys of every subscribed action
+		bool mMouse;
+	};
+
+	// recompute mWatchedKeys from every subscription
+	void RebuildWatchedKeys();
+
+	std::vector<Subscription> mSubscriptions;
+
+	// keys bound to each action, and the actions bound to each key
+	std::vector<KeySet> mActionKeys;
+	uint64_t mKeyActions[SDL_NUM_SCANCODES];
+
+	// keys at least one listener cares about (the only keys compared each frame)
+	std::vector<SDL_Scancode> mWatchedKeys;
+	// state of the watched keys last frame
+	KeySet mPrevKeys;
+	int mMouseX;
+	int mMouseY;
+
+	// this frame's events, and the subset going to the current listener (kept to avoid reallocating)
+	std::vector<InputEvent> mEvents;
+	std::vector<InputEvent> mListenerEvents;
+};
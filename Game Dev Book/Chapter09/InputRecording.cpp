@@ -0,0 +1,160 @@
+#include "InputRecording.hpp"
+#include <cstring>
+
+namespace {
+	const uint32_t RecordingMagic = 'G' | ('R' << 8) | ('E' << 16) | ('C' << 24);
+	const uint32_t RecordingVersion = 1;
+
+	template<typename T>
+	void Write(std::ofstream& file, const T& value) {
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template<typename T>
+	bool Read(std::ifstream& file, T& value) {
+		file.read(reinterpret_cast<char*>(&value), sizeof(T));
+		return static_cast<bool>(file);
+	}
+}
+
+InputRecorder::InputRecorder() {
+	memset(mPrevKeyState, 0, sizeof(mPrevKeyState));
+	mNumFrames = 0;
+}
+
+InputRecorder::~InputRecorder() {
+	Close();
+}
+
+bool InputRecorder::Open(const std::string& fileName, uint32_t seed) {
+	mFile.open(fileName, std::ios::binary | std::ios::trunc);
+	if (!mFile.is_open()) {
+		SDL_Log("Failed to open recording %s", fileName.c_str());
+		return false;
+	}
+
+	Write(mFile, RecordingMagic);
+	Write(mFile, RecordingVersion);
+	Write(mFile, seed);
+	memset(mPrevKeyState, 0, sizeof(mPrevKeyState));
+	mNumFrames = 0;
+	return true;
+}
+
+void InputRecorder::RecordFrame(const FrameInput& input) {
+	if (!mFile.is_open()) {
+		return;
+	}
+
+	Write(mFile, input.mFrameTime);
+	Write(mFile, static_cast<int32_t>(input.mMouseX));
+	Write(mFile, static_cast<int32_t>(input.mMouseY));
+
+	uint16_t numEvents = 0;
+	for (const auto& event : input.mEvents) {
+		if (IsRecordedEvent(event)) {
+			numEvents += 1;
+		}
+	}
+	Write(mFile, numEvents);
+	for (const auto& event : input.mEvents) {
+		if (IsRecordedEvent(event)) {
+			Write(mFile, event);
+		}
+	}
+
+	// only the keys that changed, most frames have none
+	mChangedKeys.clear();
+	for (uint16_t key = 0; key < SDL_NUM_SCANCODES; ++key) {
+		if ((input.mKeyState[key] != 0) != (mPrevKeyState[key] != 0)) {
+			mChangedKeys.emplace_back(key);
+		}
+	}
+	Write(mFile, static_cast<uint16_t>(mChangedKeys.size()));
+	for (uint16_t key : mChangedKeys) {
+		Write(mFile, key);
+	}
+	memcpy(mPrevKeyState, input.mKeyState, sizeof(mPrevKeyState));
+
+	mNumFrames += 1;
+}
+
+void InputRecorder::Close() {
+	if (mFile.is_open()) {
+		mFile.close();
+	}
+}
+
+bool InputRecorder::IsRecordedEvent(const SDL_Event& event) {
+	switch (event.type) {
+	case SDL_QUIT:
+	case SDL_KEYDOWN:
+	case SDL_KEYUP:
+	case SDL_MOUSEBUTTONDOWN:
+	case SDL_MOUSEBUTTONUP:
+	case SDL_MOUSEWHEEL:
+		return true;
+	default:
+		return false;
+	}
+}
+
+InputReplayer::InputReplayer() {
+	mSeed = 0;
+	memset(mKeyState, 0, sizeof(mKeyState));
+}
+
+bool InputReplayer::Open(const std::string& fileName) {
+	mFile.open(fileName, std::ios::binary);
+	if (!mFile.is_open()) {
+		SDL_Log("Failed to open recording %s", fileName.c_str());
+		return false;
+	}
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	if (!Read(mFile, magic) || !Read(mFile, version) || !Read(mFile, mSeed)) {
+		SDL_Log("Recording %s is truncated", fileName.c_str());
+		return false;
+	}
+	if (magic != RecordingMagic || version != RecordingVersion) {
+		SDL_Log("%s is not a recording this build can play (version %u)", fileName.c_str(), version);
+		return false;
+	}
+
+	memset(mKeyState, 0, sizeof(mKeyState));
+	return true;
+}
+
+bool InputReplayer::ReadFrame(FrameInput& input) {
+	int32_t mouseX = 0;
+	int32_t mouseY = 0;
+	uint16_t numEvents = 0;
+	if (!Read(mFile, input.mFrameTime) || !Read(mFile, mouseX) || !Read(mFile, mouseY) || !Read(mFile, numEvents)) {
+		return false;
+	}
+	input.mMouseX = mouseX;
+	input.mMouseY = mouseY;
+
+	input.mEvents.resize(numEvents);
+	for (auto& event : input.mEvents) {
+		if (!Read(mFile, event)) {
+			return false;
+		}
+	}
+
+	uint16_t numChanged = 0;
+	if (!Read(mFile, numChanged)) {
+		return false;
+	}
+	for (uint16_t i = 0; i < numChanged; ++i) {
+		uint16_t key = 0;
+		if (!Read(mFile, key) || key >= SDL_NUM_SCANCODES) {
+			return false;
+		}
+		mKeyState[key] = mKeyState[key] ? 0 : 1;
+	}
+	memcpy(input.mKeyState, mKeyState, sizeof(mKeyState));
+
+	return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <fstream>
+#include <string>
+#include <cstdint>
+#include "SDL/SDL.h"
+
+// everything from outside the simulation that one frame depends on
+struct FrameInput {
+	// real time since the previous frame (before clamping)
+	float mFrameTime;
+	// SDL events polled this frame
+	std::vector<SDL_Event> mEvents;
+	// keyboard state (SDL_GetKeyboardState)
+	Uint8 mKeyState[SDL_NUM_SCANCODES];
+	// relative mouse motion since the previous frame
+	int mMouseX;
+	int mMouseY;
+};
+
+// recording format (little endian, no padding):
+// header: "GREC", version, random seed (uint32 each)
+// per frame: frame time (float), mouse x/y (int32), event count (uint16) then raw SDL_Events,
+//            changed key count (uint16) then the scancodes that flipped since the previous frame (uint16)
+// only the events Game reacts to are kept, mouse motion is covered by the relative mouse state
+
+// writes a session to disk, one frame at a time
+class InputRecorder {
+public:
+	InputRecorder();
+	~InputRecorder();
+
+	bool Open(const std::string& fileName, uint32_t seed);
+	void RecordFrame(const FrameInput& input);
+	void Close();
+
+	uint32_t GetNumFrames() const {
+		return mNumFrames;
+	}
+
+	// is this an event type a recording keeps?
+	static bool IsRecordedEvent(const SDL_Event& event);
+
+private:
+	std::ofstream mFile;
+	// key state of the previous recorded frame
+	Uint8 mPrevKeyState[SDL_NUM_SCANCODES];
+	uint32_t mNumFrames;
+	// scratch list of changed keys
+	std::vector<uint16_t> mChangedKeys;
+};
+
+// reads a session back frame by frame
+class InputReplayer {
+public:
+	InputReplayer();
+
+	bool Open(const std::string& fileName);
+	// fills in the next frame, returns false once the recording is over
+	bool ReadFrame(FrameInput& input);
+
+	uint32_t GetSeed() const {
+		return mSeed;
+	}
+
+private:
+	std::ifstream mFile;
+	uint32_t mSeed;
+	// key state of the previous frame (changes are applied on top of it)
+	Uint8 mKeyState[SDL_NUM_SCANCODES];
+};
@@ -1,13 +1,59 @@
 /// This project is based off the book "Game Programming in C++"
 
 #include "Game.hpp"
+#include <cstring>
+#include <cstdlib>
 
 int main(int argc, char** argv) {
+    // "--headless N" runs N frames without window/GL/audio and reports timing
+    // "--record file" plays normally and records the session, "--replay file" plays it back headless and reports timing
+    bool headless = false;
+    uint32_t headlessFrames = 1000;
+    const char* recordFile = nullptr;
+    const char* replayFile = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+            // the frame count is optional, so only take the next argument if all of it is a number
+            if (i + 1 < argc) {
+                char* end = nullptr;
+                long frames = strtol(argv[i + 1], &end, 10);
+                if (end != argv[i + 1] && *end == '\0' && frames > 0) {
+                    headlessFrames = static_cast<uint32_t>(frames);
+                    i += 1;
+                }
+            }
+        }
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordFile = argv[i + 1];
+            i += 1;
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayFile = argv[i + 1];
+            headless = true;
+            i += 1;
+        }
+    }
+
     Game game;
+    if (recordFile != nullptr) {
+        game.SetRecording(recordFile);
+    }
+    if (replayFile != nullptr) {
+        game.SetReplay(replayFile);
+    }
 
-    bool success = game.Initialize();
+    bool success = game.Initialize(headless);
     if (success) {
-        game.RunLoop();
+        if (replayFile != nullptr) {
+            game.RunReplay();
+        }
+        else if (headless) {
+            game.RunHeadless(headlessFrames);
+        }
+        else {
+            game.RunLoop();
+        }
     }
 
     game.ShutDown();
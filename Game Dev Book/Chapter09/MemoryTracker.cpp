@@ -0,0 +1,258 @@
+#include "MemoryTracker.hpp"
+#include "Counters.hpp"
+#include "SDL/SDL.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	// in front of every tracked block (16 bytes, so the block keeps malloc's alignment)
+	struct Header {
+		uint64_t mSize;
+		uint32_t mTag;
+		uint32_t mMagic;
+	};
+	static_assert(sizeof(Header) == 16, "Header must keep 16 byte alignment");
+	const uint32_t HeaderMagic = 0x4D454D54;
+
+	// everything here is plain static storage (no constructors that allocate), since operator new uses it
+	struct TagData {
+		std::atomic<int64_t> mLiveBytes;
+		std::atomic<int64_t> mPeakBytes;
+		std::atomic<int64_t> mExternalBytes;
+		std::atomic<uint64_t> mAllocations;
+		std::atomic<uint64_t> mFrees;
+		// this frame's churn, moved to the last frame's by EndFrame
+		std::atomic<int64_t> mFrameAllocations;
+		std::atomic<int64_t> mFrameBytes;
+		int64_t mLastFrameAllocations;
+		int64_t mLastFrameBytes;
+		int64_t mBudget;
+		bool mOverBudget;
+	};
+	TagData sTags[MemoryTracker::NumTags];
+
+	thread_local MemoryTracker::Tag sCurrentTag = MemoryTracker::EUntagged;
+
+	uint32_t sReportInterval = 0;
+	uint32_t sNumFrames = 0;
+
+	const char* const sTagNames[MemoryTracker::NumTags] = {
+		"Untagged", "Renderer", "Mesh", "Texture", "Audio", "Actors", "AI", "Scratch"
+	};
+	// counter names per tag (Counters keeps the pointer)
+	const char* const sLiveCounters[MemoryTracker::NumTags] = {
+		"MemLive.Untagged", "MemLive.Renderer", "MemLive.Mesh", "MemLive.Texture",
+		"MemLive.Audio", "MemLive.Actors", "MemLive.AI", "MemLive.Scratch"
+	};
+	const char* const sChurnCounters[MemoryTracker::NumTags] = {
+		"MemAllocs.Untagged", "MemAllocs.Renderer", "MemAllocs.Mesh", "MemAllocs.Texture",
+		"MemAllocs.Audio", "MemAllocs.Actors", "MemAllocs.AI", "MemAllocs.Scratch"
+	};
+
+	void OnAllocate(uint32_t tag, int64_t size) {
+		TagData& data = sTags[tag];
+		int64_t live = data.mLiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+		int64_t peak = data.mPeakBytes.load(std::memory_order_relaxed);
+		while (live > peak && !data.mPeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+		}
+		data.mAllocations.fetch_add(1, std::memory_order_relaxed);
+		data.mFrameAllocations.fetch_add(1, std::memory_order_relaxed);
+		data.mFrameBytes.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	void OnFree(uint32_t tag, int64_t size) {
+		TagData& data = sTags[tag];
+		data.mLiveBytes.fetch_sub(size, std::memory_order_relaxed);
+		data.mFrees.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	Header* GetHeader(void* ptr) {
+		Header* header = static_cast<Header*>(ptr) - 1;
+		if (header->mMagic != HeaderMagic) {
+			SDL_Log("MemoryTracker: block %p wasn't allocated by the tracker (or was already freed)", ptr);
+		}
+		return header;
+	}
+}
+
+void* MemoryTracker::Allocate(size_t size, Tag tag) {
+	Header* header = static_cast<Header*>(malloc(sizeof(Header) + size));
+	if (header == nullptr) {
+		return nullptr;
+	}
+	header->mSize = size;
+	header->mTag = tag;
+	header->mMagic = HeaderMagic;
+	OnAllocate(tag, static_cast<int64_t>(size));
+	return header + 1;
+}
+
+void* MemoryTracker::Reallocate(void* ptr, size_t size, Tag tag) {
+	if (ptr == nullptr) {
+		return Allocate(size, tag);
+	}
+
+	Header* header = GetHeader(ptr);
+	uint32_t oldTag = header->mTag;
+	int64_t oldSize = static_cast<int64_t>(header->mSize);
+	Header* newHeader = static_cast<Header*>(realloc(header, sizeof(Header) + size));
+	if (newHeader == nullptr) {
+		return nullptr;
+	}
+	newHeader->mSize = size;
+	OnFree(oldTag, oldSize);
+	OnAllocate(oldTag, static_cast<int64_t>(size));
+	return newHeader + 1;
+}
+
+void MemoryTracker::Free(void* ptr) {
+	if (ptr == nullptr) {
+		return;
+	}
+	Header* header = GetHeader(ptr);
+	OnFree(header->mTag, static_cast<int64_t>(header->mSize));
+	header->mMagic = 0;
+	free(header);
+}
+
+void MemoryTracker::AddExternal(Tag tag, int64_t bytes) {
+	sTags[tag].mExternalBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::RemoveExternal(Tag tag, int64_t bytes) {
+	sTags[tag].mExternalBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+MemoryTracker::Tag MemoryTracker::GetCurrentTag() {
+	return sCurrentTag;
+}
+
+void MemoryTracker::SetCurrentTag(Tag tag) {
+	sCurrentTag = tag;
+}
+
+MemoryTracker::Stats MemoryTracker::GetStats(Tag tag) {
+	TagData& data = sTags[tag];
+	Stats stats;
+	stats.mLiveBytes = data.mLiveBytes.load(std::memory_order_relaxed);
+	stats.mPeakBytes = data.mPeakBytes.load(std::memory_order_relaxed);
+	stats.mExternalBytes = data.mExternalBytes.load(std::memory_order_relaxed);
+	stats.mAllocations = data.mAllocations.load(std::memory_order_relaxed);
+	stats.mFrees = data.mFrees.load(std::memory_order_relaxed);
+	stats.mFrameAllocations = data.mLastFrameAllocations;
+	stats.mFrameBytes = data.mLastFrameBytes;
+	stats.mBudget = data.mBudget;
+	return stats;
+}
+
+const char* MemoryTracker::GetTagName(Tag tag) {
+	return tag < NumTags ? sTagNames[tag] : "";
+}
+
+void MemoryTracker::SetBudget(Tag tag, int64_t bytes) {
+	sTags[tag].mBudget = bytes;
+	sTags[tag].mOverBudget = false;
+}
+
+void MemoryTracker::SetReportInterval(uint32_t frames) {
+	sReportInterval = frames;
+}
+
+void MemoryTracker::EndFrame() {
+	static uint32_t liveIds[NumTags];
+	static uint32_t churnIds[NumTags];
+	static bool registered = false;
+	if (!registered) {
+		for (uint32_t tag = 0; tag < NumTags; ++tag) {
+			liveIds[tag] = Counters::Register(sLiveCounters[tag], Counters::EGauge);
+			churnIds[tag] = Counters::Register(sChurnCounters[tag]);
+		}
+		registered = true;
+	}
+
+	for (uint32_t tag = 0; tag < NumTags; ++tag) {
+		TagData& data = sTags[tag];
+		data.mLastFrameAllocations = data.mFrameAllocations.exchange(0, std::memory_order_relaxed);
+		data.mLastFrameBytes = data.mFrameBytes.exchange(0, std::memory_order_relaxed);
+
+		int64_t live = data.mLiveBytes.load(std::memory_order_relaxed);
+		int64_t total = live + data.mExternalBytes.load(std::memory_order_relaxed);
+		Counters::Set(liveIds[tag], total);
+		Counters::Add(churnIds[tag], data.mLastFrameAllocations);
+
+		// warn once each time a tag goes over its budget
+		bool overBudget = data.mBudget > 0 && total > data.mBudget;
+		if (overBudget && !data.mOverBudget) {
+			SDL_Log("Memory tag %s is over budget: %lld of %lld bytes", sTagNames[tag],
+				static_cast<long long>(total), static_cast<long long>(data.mBudget));
+		}
+		data.mOverBudget = overBudget;
+	}
+
+	sNumFrames += 1;
+	if (sReportInterval > 0 && sNumFrames % sReportInterval == 0) {
+		LogReport();
+	}
+}
+
+void MemoryTracker::LogReport() {
+	SDL_Log("Memory by tag (KB live / peak / external, allocs / frees, last frame allocs / KB):");
+	for (uint32_t tag = 0; tag < NumTags; ++tag) {
+		Stats stats = GetStats(static_cast<Tag>(tag));
+		SDL_Log("  %-9s %10.1f %10.1f %10.1f  %10llu %10llu  %6lld %8.1f%s", sTagNames[tag],
+			stats.mLiveBytes / 1024.0, stats.mPeakBytes / 1024.0, stats.mExternalBytes / 1024.0,
+			static_cast<unsigned long long>(stats.mAllocations), static_cast<unsigned long long>(stats.mFrees),
+			static_cast<long long>(stats.mFrameAllocations), stats.mFrameBytes / 1024.0,
+			sTags[tag].mOverBudget ? "  OVER BUDGET" : "");
+	}
+}
+
+// every heap allocation goes through the tracker
+void* operator new(size_t size) {
+	Counters::CountAllocation(size);
+	void* ptr = MemoryTracker::Allocate(size != 0 ? size : 1, MemoryTracker::GetCurrentTag());
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+	MemoryTracker::Free(ptr);
+}
+
+// the array, nothrow and sized forms go through the tracker too (the library's own versions may not, and a sized
+// delete that skipped the tracker would free a pointer that is past the tracker's header)
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	Counters::CountAllocation(size);
+	return MemoryTracker::Allocate(size != 0 ? size : 1, MemoryTracker::GetCurrentTag());
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+	return operator new(size, tag);
+}
+
+void operator delete[](void* ptr) noexcept {
+	MemoryTracker::Free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+	MemoryTracker::Free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+	MemoryTracker::Free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+	MemoryTracker::Free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+	MemoryTracker::Free(ptr);
+}
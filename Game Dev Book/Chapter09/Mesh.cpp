@@ -118,7 +118,10 @@ bool Mesh::Load(const std::string& fileName, class Renderer* rend) {
 		indices.emplace_back(ind[2].GetUint());
 	}
 
-	// finally, create a vertex array
+	// finally, create a vertex array (not without a GL context)
+	if (rend->IsHeadless()) {
+		return true;
+	}
 	mVertexArray = new VertexArray(vertices.data(), static_cast<unsigned>(vertices.size()) / vertSize,
 		indices.data(), static_cast<unsigned>(indices.size()));
 	return true;
@@ -6,6 +6,7 @@
 #include "Shader.hpp"
 #include "VertexArray.hpp"
 #include "Mesh.hpp"
+#include "RenderQueue.hpp"
 
 MeshComponent::MeshComponent(Actor* owner, Mesh* mesh) : Component(owner) {
 	// set the mesh/texture index used by mesh component
@@ -18,23 +19,16 @@ MeshComponent::~MeshComponent() {
 	mOwner->GetGame()->GetRenderer()->RemoveMeshComp(this);
 }
 
-void MeshComponent::Draw(Shader* shader) {
+void MeshComponent::Submit(RenderQueue* queue, Shader* shader, Shader* instancedShader) {
 	if (mMesh) {
-		// set the world transform matrix uniform
-		shader->SetMatrixUniform("uWorldTransform", mOwner->GetWorldTransform());
-		// set specular power
-		shader->SetFloatUniform("uSpecPower", mMesh->GetSpecPower());
-
-		// set the active texture
-		Texture* t = mMesh->GetTexture(mTextureIndex);
-		if (t) {
-			t->SetActive();
-		}
-		// set the mesh's vertex array as active
-		VertexArray* va = mMesh->GetVertexArray();
-		va->SetActive();
-
-		// draw the triangles
-		glDrawElements(GL_TRIANGLES, va->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+		RenderQueue::DrawCommand command;
+		command.mShader = shader;
+		command.mInstancedShader = instancedShader;
+		// the texture to use (can be null, then whatever is bound stays)
+		command.mTexture = mMesh->GetTexture(mTextureIndex);
+		command.mVertexArray = mMesh->GetVertexArray();
+		command.mWorldTransform = mOwner->GetRenderTransform();
+		command.mSpecPower = mMesh->GetSpecPower();
+		queue->SubmitOpaque(command);
 	}
 }
@@ -4,12 +4,20 @@
 #include <string>
 
 class MeshComponent : public Component {
+	DECLARE_COMPONENT_TYPE(MeshComponent, Component)
+
 public:
 	MeshComponent(class Actor* owner, class Mesh* mesh);
 	~MeshComponent();
 
-	// draw this mesh component
-	virtual void Draw(class Shader* shader);
+	// only drawn/queried, never updated
+	bool NeedsUpdate() const override {
+		return false;
+	}
+
+	// queue this mesh component to be drawn with the given shader
+	// (or its instanced variant, when the queue batches it with other draws of the same mesh)
+	virtual void Submit(class RenderQueue* queue, class Shader* shader, class Shader* instancedShader);
 
 	void SetTextureIndex(size_t index) {
 		mTextureIndex = index;
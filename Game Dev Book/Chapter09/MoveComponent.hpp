@@ -1,10 +1,14 @@
 #pragma once
 
 #include "Component.hpp"
+#include "ComponentPool.hpp"
 #include "Math.hpp"
 
 // allows actors to move forward at a certain speed and update the rotation
 class MoveComponent : public Component {
+	DECLARE_POOLED_COMPONENT(MoveComponent, 10)
+	DECLARE_COMPONENT_TYPE(MoveComponent, Component)
+
 public:
 	// lower update order to update first
 	MoveComponent(class Actor* owner, int updateOrder = 10);
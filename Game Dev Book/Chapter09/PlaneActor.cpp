@@ -5,6 +5,8 @@
 
 PlaneActor::PlaneActor(Game* game) : Actor(game) {
 	SetScale(10.0f);
+	// floor/wall pieces never move
+	SetStatic(true);
 	MeshComponent* mc = new MeshComponent(this, 
 		GetGame()->GetRenderer()->GetMesh("Assets/Plane.gpmesh"));
 }
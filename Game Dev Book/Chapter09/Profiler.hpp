@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// scoped-timer profiler, exporting chrome://tracing / Perfetto JSON
+// - PROFILE_SCOPE("name") times the rest of the enclosing scope (name must be a string literal)
+// - PROFILE_FRAME() marks the start of a new frame (events are tagged with the frame they happen in)
+// - each thread writes into its own ring buffer (no locks, only the owning thread writes), with
+//   nanosecond timestamps; the most recent BufferSize events per thread are kept
+// - Profiler::WriteChromeTrace dumps a frame range (call it between frames, while no other thread is recording)
+// - only compiled in when ENABLE_PROFILER is defined (Debug builds), otherwise the macros are empty
+class Profiler {
+public:
+	// nanoseconds since the profiler started
+	static uint64_t GetTime();
+
+	static void BeginFrame();
+	static uint32_t GetFrame();
+
+	// store a finished scope in the calling thread's buffer
+	static void Record(const char* name, uint64_t start, uint64_t end);
+
+	// write every recorded event in [firstFrame, lastFrame] to a trace file, returns false on failure
+	static bool WriteChromeTrace(const std::string& fileName, uint32_t firstFrame, uint32_t lastFrame);
+
+	// events kept per thread
+	static const size_t BufferSize = 1 << 16;
+};
+
+// records the time between construction and destruction
+class ProfileScope {
+public:
+	ProfileScope(const char* name) {
+		mName = name;
+		mStart = Profiler::GetTime();
+	}
+	~ProfileScope() {
+		Profiler::Record(mName, mStart, Profiler::GetTime());
+	}
+
+private:
+	const char* mName;
+	uint64_t mStart;
+};
+
+#ifdef ENABLE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FRAME() Profiler::BeginFrame()
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_FRAME()
+#endif
@@ -0,0 +1,269 @@
+#include "RenderQueue.hpp"
+#include <GL/glew.h>
+#include <cstring>
+#include "Shader.hpp"
+#include "Texture.hpp"
+#include "VertexArray.hpp"
+#include "Profiler.hpp"
+#include "Counters.hpp"
+#include "MemoryTracker.hpp"
+
+namespace {
+	// key fields, from the top (GL object names are small integers, so the low bits tell them apart)
+	const uint32_t PassBits = 2;
+	const uint32_t ShaderBits = 6;
+	const uint32_t TextureBits = 12;
+	const uint32_t MeshBits = 12;
+
+	uint64_t Field(uint32_t value, uint32_t bits, uint32_t shift) {
+		return (static_cast<uint64_t>(value) & ((1ull << bits) - 1)) << shift;
+	}
+
+	uint32_t GetTextureName(Texture* texture) {
+		return texture ? texture->GetTextureID() : 0;
+	}
+}
+
+RenderQueue::RenderQueue() {
+	mCameraPos = Vector3::Zero;
+	// storage is made on first use
+	glGenBuffers(1, &mInstanceBuffer);
+	mInstanceCapacity = 0;
+}
+
+RenderQueue::~RenderQueue() {
+	glDeleteBuffers(1, &mInstanceBuffer);
+	MemoryTracker::RemoveExternal(MemoryTracker::ERenderer, static_cast<int64_t>(mInstanceCapacity));
+}
+
+void RenderQueue::Begin(const Vector3& cameraPos) {
+	mCameraPos = cameraPos;
+	// keeps the capacity, so a steady scene doesn't allocate
+	mCommands.clear();
+	mItems.clear();
+}
+
+void RenderQueue::SubmitOpaque(const DrawCommand& command) {
+	// distance to the camera as the low 32 bits (the bits of a positive float sort like the float)
+	float depth = (command.mWorldTransform.GetTranslation() - mCameraPos).Length();
+	uint32_t depthBits = 0;
+	memcpy(&depthBits, &depth, sizeof(depthBits));
+
+	uint32_t shift = 64;
+	uint64_t key = Field(EOpaque, PassBits, shift -= PassBits);
+	key |= Field(command.mShader->GetProgramID(), ShaderBits, shift -= ShaderBits);
+	key |= Field(GetTextureName(command.mTexture), TextureBits, shift -= TextureBits);
+	key |= Field(command.mVertexArray->GetArrayID(), MeshBits, shift -= MeshBits);
+	key |= depthBits;
+
+	mItems.push_back({key, static_cast<uint32_t>(mCommands.size())});
+	mCommands.push_back(command);
+}
+
+void RenderQueue::SubmitTranslucent(const DrawCommand& command, int drawOrder) {
+	// flip the sign bit, so negative draw orders sort before positive ones
+	uint32_t order = static_cast<uint32_t>(drawOrder) ^ 0x80000000u;
+
+	uint32_t shift = 64;
+	uint64_t key = Field(ETranslucent, PassBits, shift -= PassBits);
+	key |= Field(order, 32, shift -= 32);
+	// then the submission index in the remaining bits (not the state: blending depends on the order)
+	key |= Field(static_cast<uint32_t>(mCommands.size()), shift, 0);
+
+	mItems.push_back({key, static_cast<uint32_t>(mCommands.size())});
+	mCommands.push_back(command);
+}
+
+void RenderQueue::Sort() {
+	PROFILE_SCOPE("RenderQueue::Sort");
+
+	// least significant digit radix sort, one byte per pass
+	mSortScratch.resize(mItems.size());
+	SortItem* from = mItems.data();
+	SortItem* to = mSortScratch.data();
+	size_t numItems = mItems.size();
+
+	for (uint32_t shift = 0; shift < 64; shift += 8) {
+		size_t counts[256] = {};
+		for (size_t i = 0; i < numItems; ++i) {
+			counts[(from[i].mKey >> shift) & 0xff] += 1;
+		}
+		// every key has the same byte here (unused fields, or the same pass): nothing to reorder
+		if (numItems == 0 || counts[(from[0].mKey >> shift) & 0xff] == numItems) {
+			continue;
+		}
+
+		size_t offset = 0;
+		for (size_t& count : counts) {
+			size_t bucketSize = count;
+			count = offset;
+			offset += bucketSize;
+		}
+		for (size_t i = 0; i < numItems; ++i) {
+			to[counts[(from[i].mKey >> shift) & 0xff]++] = from[i];
+		}
+		std::swap(from, to);
+	}
+
+	// an odd number of passes left the result in the scratch buffer
+	if (from != mItems.data()) {
+		mItems.swap(mSortScratch);
+	}
+}
+
+void RenderQueue::Execute() {
+	PROFILE_SCOPE("RenderQueue::Execute");
+
+	BuildBatches();
+	UploadInstances();
+
+	// nothing is bound yet
+	bool first = true;
+	Pass lastPass = EOpaque;
+	Shader* lastShader = nullptr;
+	Texture* lastTexture = nullptr;
+	VertexArray* lastVertexArray = nullptr;
+	float lastSpecPower = 0.0f;
+
+	for (const Batch& batch : mBatches) {
+		const SortItem& item = mItems[batch.mFirst];
+		const DrawCommand& command = mCommands[item.mCommand];
+		Pass pass = static_cast<Pass>(item.mKey >> (64 - PassBits));
+		Shader* shader = batch.mInstanced ? command.mInstancedShader : command.mShader;
+
+		if (first || pass != lastPass) {
+			SetPassState(pass);
+		}
+		// the material uniform is per program, so a new shader needs it set again
+		bool newShader = first || shader != lastShader;
+		if (newShader) {
+			shader->SetActive();
+		}
+		if (command.mTexture && (first || command.mTexture != lastTexture)) {
+			command.mTexture->SetActive();
+		}
+		if (first || command.mVertexArray != lastVertexArray) {
+			command.mVertexArray->SetActive();
+		}
+		if (pass == EOpaque && (newShader || lastPass != EOpaque || command.mSpecPower != lastSpecPower)) {
+			shader->SetFloatUniform(UNIFORM_NAME("uSpecPower"), command.mSpecPower);
+		}
+
+		if (batch.mInstanced) {
+			command.mVertexArray->SetInstanceBuffer(mInstanceBuffer, batch.mFirstInstance * sizeof(Matrix4));
+			glDrawElementsInstanced(GL_TRIANGLES, command.mVertexArray->GetNumIndices(), GL_UNSIGNED_INT, nullptr, batch.mCount);
+			COUNTER_ADD("InstancedDrawCalls", 1);
+			COUNTER_ADD("Instances", batch.mCount);
+		}
+		else {
+			shader->SetMatrixUniform(UNIFORM_NAME("uWorldTransform"), command.mWorldTransform);
+			glDrawElements(GL_TRIANGLES, command.mVertexArray->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+		}
+		COUNTER_ADD("DrawCalls", 1);
+
+		first = false;
+		lastPass = pass;
+		lastShader = shader;
+		if (command.mTexture) {
+			lastTexture = command.mTexture;
+		}
+		lastVertexArray = command.mVertexArray;
+		lastSpecPower = command.mSpecPower;
+	}
+}
+
+void RenderQueue::BuildBatches() {
+	mBatches.clear();
+	mInstanceData.clear();
+
+	uint32_t numItems = static_cast<uint32_t>(mItems.size());
+	for (uint32_t first = 0; first < numItems; ) {
+		const DrawCommand& command = mCommands[mItems[first].mCommand];
+		Pass pass = static_cast<Pass>(mItems[first].mKey >> (64 - PassBits));
+
+		// how many of the following draws share this one's state
+		// (opaque draws only: depth testing makes their order within the run irrelevant)
+		uint32_t count = 1;
+		if (pass == EOpaque && command.mInstancedShader) {
+			while (first + count < numItems) {
+				const SortItem& next = mItems[first + count];
+				const DrawCommand& other = mCommands[next.mCommand];
+				if (static_cast<Pass>(next.mKey >> (64 - PassBits)) != pass ||
+					other.mShader != command.mShader ||
+					other.mInstancedShader != command.mInstancedShader ||
+					other.mTexture != command.mTexture ||
+					other.mVertexArray != command.mVertexArray ||
+					other.mSpecPower != command.mSpecPower) {
+					break;
+				}
+				count += 1;
+			}
+		}
+
+		if (count >= MinInstances) {
+			Batch batch;
+			batch.mFirst = first;
+			batch.mCount = count;
+			batch.mFirstInstance = static_cast<uint32_t>(mInstanceData.size());
+			batch.mInstanced = true;
+			mBatches.push_back(batch);
+			for (uint32_t i = first; i < first + count; ++i) {
+				mInstanceData.push_back(mCommands[mItems[i].mCommand].mWorldTransform);
+			}
+		}
+		else {
+			// too few to be worth it, draw them one by one
+			for (uint32_t i = first; i < first + count; ++i) {
+				Batch batch;
+				batch.mFirst = i;
+				batch.mCount = 1;
+				batch.mFirstInstance = 0;
+				batch.mInstanced = false;
+				mBatches.push_back(batch);
+			}
+		}
+		first += count;
+	}
+}
+
+void RenderQueue::UploadInstances() {
+	if (mInstanceData.empty()) {
+		return;
+	}
+
+	size_t size = mInstanceData.size() * sizeof(Matrix4);
+	glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+	if (size > mInstanceCapacity) {
+		// grow to fit (doubling, so a slowly growing scene doesn't change the size every frame)
+		size_t capacity = mInstanceCapacity > 0 ? mInstanceCapacity : 64 * sizeof(Matrix4);
+		while (capacity < size) {
+			capacity *= 2;
+		}
+		MemoryTracker::AddExternal(MemoryTracker::ERenderer, static_cast<int64_t>(capacity - mInstanceCapacity));
+		mInstanceCapacity = capacity;
+	}
+	// fresh storage every frame, so the driver doesn't wait for last frame's draws to finish with it
+	glBufferData(GL_ARRAY_BUFFER, mInstanceCapacity, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, mInstanceData.data());
+}
+
+void RenderQueue::SetPassState(Pass pass) {
+	if (pass == EOpaque) {
+		// enable depth buffering & disable alpha blend
+		glEnable(GL_DEPTH_TEST);
+		glDisable(GL_BLEND);
+	}
+	else {
+		// disable depth buffering
+		glDisable(GL_DEPTH_TEST);
+		// enable alpha blending to support transparency
+		glEnable(GL_BLEND);  // turn on color buffer blending
+		glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+		glBlendFuncSeparate(
+			GL_SRC_ALPHA,  // sourceAlpha is srcAlpha
+			GL_ONE_MINUS_SRC_ALPHA,  // destinationFactor is 1 - sourceAlpha
+			GL_ONE,
+			GL_ZERO
+		);
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "Math.hpp"
+
+// collects the draws of a frame and issues them in an order that minimizes GL state changes
+// - every draw gets a 64-bit sort key, most significant field first:
+//   opaque:      pass | shader | texture | mesh | depth (front to back)
+//   translucent: pass | draw order | submission index (painter's algorithm, so equal draw orders keep
+//                submission order instead of being regrouped by state, overlapping sprites blend as before)
+// - keys are radix sorted once per frame (stable, so equal keys keep submission order)
+// - Execute only binds a shader/texture/vertex array or sets a material uniform when it differs from the previous draw
+// - after sorting, runs of opaque draws with the same state (same mesh, texture and material) become one
+//   instanced draw: their world transforms go into an instance buffer (one upload per frame) and
+//   the command's instanced shader reads them per instance
+class RenderQueue {
+public:
+	enum Pass {
+		EOpaque,
+		ETranslucent
+	};
+
+	struct DrawCommand {
+		class Shader* mShader;
+		// variant of mShader that takes the world transform per instance (null if there is none)
+		class Shader* mInstancedShader;
+		class Texture* mTexture;
+		class VertexArray* mVertexArray;
+		Matrix4 mWorldTransform;
+		// material (only used by the opaque pass)
+		float mSpecPower;
+	};
+
+	RenderQueue();
+	~RenderQueue();
+
+	// start a new frame (cameraPos is used for the depth of opaque draws)
+	void Begin(const Vector3& cameraPos);
+
+	void SubmitOpaque(const DrawCommand& command);
+	// lower draw order is drawn first
+	void SubmitTranslucent(const DrawCommand& command, int drawOrder);
+
+	// sort the submitted draws by key
+	void Sort();
+	// issue the sorted draws
+	void Execute();
+
+	// fewest draws with the same state that are worth an instanced draw
+	static const uint32_t MinInstances = 2;
+
+	size_t GetNumDraws() const {
+		return mCommands.size();
+	}
+
+private:
+	struct SortItem {
+		uint64_t mKey;
+		// index into mCommands
+		uint32_t mCommand;
+	};
+
+	// consecutive sorted draws issued by one draw call
+	struct Batch {
+		// first of the draws in mItems
+		uint32_t mFirst;
+		uint32_t mCount;
+		// first world transform in mInstanceData, for an instanced batch
+		uint32_t mFirstInstance;
+		bool mInstanced;
+	};
+
+	// group the sorted draws into batches and gather the instance data
+	void BuildBatches();
+	// upload mInstanceData to the instance buffer
+	void UploadInstances();
+	// set up depth test and blending for a pass
+	void SetPassState(Pass pass);
+
+	Vector3 mCameraPos;
+	std::vector<DrawCommand> mCommands;
+	std::vector<SortItem> mItems;
+	// scratch space for the radix sort
+	std::vector<SortItem> mSortScratch;
+
+	std::vector<Batch> mBatches;
+	// world transforms of every instanced batch, back to back
+	std::vector<Matrix4> mInstanceData;
+	// OpenGL ID of the instance buffer, and its size in bytes
+	unsigned int mInstanceBuffer;
+	size_t mInstanceCapacity;
+};
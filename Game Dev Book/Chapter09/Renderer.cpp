@@ -1,24 +1,87 @@
 #include "Renderer.hpp"
+#include "Profiler.hpp"
+#include "MemoryTracker.hpp"
 #include <GL/glew.h>
 #include "Shader.hpp"
 #include "Texture.hpp"
 #include "Mesh.hpp"
 #include "VertexArray.hpp"
+#include "UniformBuffer.hpp"
+#include "RenderQueue.hpp"
 #include "MeshComponent.hpp"
 #include "SpriteComponent.hpp"
+#include <cstddef>
+
+namespace {
+    // memory layout of the FrameData uniform block (std140: every vec3 and struct starts on 16 bytes)
+    struct GPUDirectionalLight {
+        Vector3 mDirection;
+        float mPad0;
+        Vector3 mDiffuseColor;
+        float mPad1;
+        Vector3 mSpecColor;
+        float mPad2;
+    };
+
+    struct GPUPointLight {
+        Vector3 mPosition;
+        float mPad0;
+        Vector3 mDiffuseColor;
+        float mPad1;
+        // the float after a vec3 fills its padding
+        Vector3 mSpecColor;
+        float mRadius;
+    };
+
+    struct FrameData {
+        Matrix4 mViewProj;
+        Matrix4 mSpriteViewProj;
+        Vector3 mCameraPos;
+        float mPad0;
+        Vector3 mAmbientLight;
+        float mPad1;
+        GPUDirectionalLight mDirLight;
+        GPUPointLight mPointLights[Renderer::MaxPointLights];
+        int32_t mNumPointLights;
+        // a block's size is rounded up to 16 bytes
+        int32_t mPad2[3];
+    };
+
+    static_assert(offsetof(FrameData, mCameraPos) == 128, "FrameData doesn't match the std140 layout");
+    static_assert(offsetof(FrameData, mDirLight) == 160, "FrameData doesn't match the std140 layout");
+    static_assert(offsetof(FrameData, mPointLights) == 208, "FrameData doesn't match the std140 layout");
+    static_assert(offsetof(FrameData, mNumPointLights) == 208 + 48 * Renderer::MaxPointLights, "FrameData doesn't match the std140 layout");
+}
 
 Renderer::Renderer(Game* game) {
 	mGame = game;
 	mSpriteShader = nullptr;
     mMeshShader = nullptr;
+    mMeshInstancedShader = nullptr;
+    mCamera = nullptr;
+    mSpriteVerts = nullptr;
+    mFrameData = nullptr;
+    mRenderQueue = nullptr;
+    mHeadless = false;
+    mWindow = nullptr;
+    mContext = nullptr;
 }
 
 Renderer::~Renderer() {
 }
 
-bool Renderer::Initialize(float screenWidth, float screenHeight) {
+bool Renderer::Initialize(float screenWidth, float screenHeight, bool headless) {
 	mScreenWidth = screenWidth;
 	mScreenHeight = screenHeight;
+	mHeadless = headless;
+    MEMORY_TAG_SCOPE(ERenderer);
+
+    if (mHeadless) {
+        // same view/projection LoadShaders would set, in case anything asks for them
+        mView = Matrix4::CreateLookAt(Vector3::Zero, Vector3::UnitX, Vector3::UnitZ);
+        mProjection = Matrix4::CreatePerspectiveFOV(Math::ToRadians(70.0f), mScreenWidth, mScreenHeight, 10.0f, 10000.0f);
+        return true;
+    }
 
     // request OpenGL attributes and configure them
     // use the core OpenGL profile for desktop environment
@@ -74,15 +137,28 @@ bool Renderer::Initialize(float screenWidth, float screenHeight) {
     // create quad for drawing sprites
     CreateSpriteVerts();
 
+    // camera and lights for every shader, filled in once per frame
+    mFrameData = new UniformBuffer(sizeof(FrameData), FrameDataBinding);
+
+    mRenderQueue = new RenderQueue();
+
     return true;
 }
 
 void Renderer::Shutdown() {
+    if (mHeadless) {
+        return;
+    }
+
     delete mSpriteVerts;
+    delete mFrameData;
+    delete mRenderQueue;
     mSpriteShader->Unload();
     delete mSpriteShader;
     mMeshShader->Unload();
     delete mMeshShader;
+    mMeshInstancedShader->Unload();
+    delete mMeshInstancedShader;
 
     SDL_GL_DeleteContext(mContext);
     SDL_DestroyWindow(mWindow);
@@ -105,6 +181,13 @@ void Renderer::UnloadData() {
 }
 
 void Renderer::Draw() {
+    PROFILE_SCOPE("Renderer::Draw");
+    MEMORY_TAG_SCOPE(ERenderer);
+
+    if (mHeadless) {
+        return;
+    }
+
     // set the clear color to light gray
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
@@ -112,47 +195,24 @@ void Renderer::Draw() {
     // to the maximum depth value in normalized device coords (1.0)
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    // PHASE 1: RENDER 3D OBJECTS
-    // draw mesh components
-    // enable depth buffering & disable alpha blend
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
-
-    // set the mesh shader active
-    mMeshShader->SetActive();
-    // recalculate view-projection matrix every frame to account for a moving camera
-    mMeshShader->SetMatrixUniform("uViewProj", mView * mProjection);
-    
-    // update lighting uniforms
-    SetLightUniforms(mMeshShader);
+    // one upload of the view-projection (it changes with the camera every frame) and lights, for every shader
+    UpdateFrameData();
 
+    // queue every mesh (3D, opaque) and sprite (2D, translucent), sorted to keep state changes down
+    Matrix4 invView = mView;
+    invView.Invert();
+    mRenderQueue->Begin(invView.GetTranslation());
     for (auto mc : mMeshComps) {
-        mc->Draw(mMeshShader);
+        mc->Submit(mRenderQueue, mMeshShader, mMeshInstancedShader);
     }
-
-    // PHASE 2: RENDER 2D SPRITES
-    // draw sprite components
-    // disable depth buffering
-    glDisable(GL_DEPTH_TEST);
-    // enable alpha blending to support transparency
-    glEnable(GL_BLEND);  // turn on color buffer blending
-    glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
-    glBlendFuncSeparate(
-        GL_SRC_ALPHA,  // sourceAlpha is srcAlpha
-        GL_ONE_MINUS_SRC_ALPHA,  // destinationFactor is 1 - sourceAlpha
-        GL_ONE,
-        GL_ZERO
-    );
-
-    // set sprite shader and vertex array objects active
-    mSpriteShader->SetActive();
-    mSpriteVerts->SetActive();
-
     for (auto sprite : mSprites) {
-        sprite->Draw(mSpriteShader);
+        sprite->Submit(mRenderQueue, mSpriteShader, mSpriteVerts);
     }
+    mRenderQueue->Sort();
+    mRenderQueue->Execute();
 
     // swap the front and back buffers, which also displays the scene
+    PROFILE_SCOPE("Renderer::SwapWindow");
     SDL_GL_SwapWindow(mWindow);
 }
 
@@ -182,6 +242,17 @@ void Renderer::AddMeshComp(MeshComponent* mesh) {
     mMeshComps.emplace_back(mesh);
 }
 
+void Renderer::AddPointLight(PointLight* light) {
+    mPointLights.emplace_back(light);
+}
+
+void Renderer::RemovePointLight(PointLight* light) {
+    auto iter = std::find(mPointLights.begin(), mPointLights.end(), light);
+    if (iter != mPointLights.end()) {
+        mPointLights.erase(iter);
+    }
+}
+
 void Renderer::RemoveMeshComp(MeshComponent* mesh) {
     auto iter = std::find(mMeshComps.begin(), mMeshComps.end(), mesh);
     if (iter != mMeshComps.end()) {
@@ -190,10 +261,15 @@ void Renderer::RemoveMeshComp(MeshComponent* mesh) {
 }
 
 Texture* Renderer::GetTexture(const std::string& fileName) {
+    MEMORY_TAG_SCOPE(ETexture);
     if (mTextures.find(fileName) == mTextures.end()) {
         // load from file
         Texture* newTex = new Texture();
-        if (newTex->Load(fileName)) {
+        if (mHeadless) {
+            // nothing to upload to, so just keep an empty placeholder
+            mTextures.emplace(fileName, newTex);
+        }
+        else if (newTex->Load(fileName)) {
             mTextures.emplace(fileName, newTex);
         }
         else {
@@ -207,6 +283,7 @@ Texture* Renderer::GetTexture(const std::string& fileName) {
 }
 
 Mesh* Renderer::GetMesh(const std::string& fileName) {
+    MEMORY_TAG_SCOPE(EMesh);
     if (mMeshes.find(fileName) == mMeshes.end()) {
         // load from file
         Mesh* newMesh = new Mesh();
@@ -230,21 +307,25 @@ bool Renderer::LoadShaders() {
         return false;
     }
 
-    // set this shader as active
-    mSpriteShader->SetActive();
-
-    // create and set the view-projection matrix to the simple view projection
-    Matrix4 viewProj = Matrix4::CreateSimpleViewProj(mScreenWidth, mScreenHeight);
-    mSpriteShader->SetMatrixUniform("uViewProj", viewProj);
+    // the view-projection comes from the FrameData block
+    mSpriteShader->BindUniformBlock("FrameData", FrameDataBinding);
 
     // create basic mesh shader
     mMeshShader = new Shader();
     if (!mMeshShader->Load("Shaders/Phong.vert", "Shaders/Phong.frag")) {
         return false;
     }
-    mMeshShader->SetActive();
+    // view-projection and lights come from the FrameData block
+    mMeshShader->BindUniformBlock("FrameData", FrameDataBinding);
 
-    // set the view-projection matrix
+    // same shading, for many copies of a mesh in one draw call (world transforms per instance)
+    mMeshInstancedShader = new Shader();
+    if (!mMeshInstancedShader->Load("Shaders/PhongInstanced.vert", "Shaders/Phong.frag")) {
+        return false;
+    }
+    mMeshInstancedShader->BindUniformBlock("FrameData", FrameDataBinding);
+
+    // set up the view-projection matrix
     // view matrix is a look-at matrix facing down the x-axis
     mView = Matrix4::CreateLookAt(
         Vector3::Zero,  // camera position
@@ -259,7 +340,6 @@ bool Renderer::LoadShaders() {
         10.0f,  // near plane distance
         10000.0f  // far plane distance
     );
-    mMeshShader->SetMatrixUniform("uViewProj", mView * mProjection);
 
     return true;
 }
@@ -282,17 +362,39 @@ void Renderer::CreateSpriteVerts() {
     mSpriteVerts = new VertexArray(vertices, 4, indices, 6);
 }
 
-void Renderer::SetLightUniforms(Shader* shader) {
+void Renderer::UpdateFrameData() {
+    // value-initialized: vectors and padding are zero, no point lights
+    FrameData data{};
+
+    data.mViewProj = mView * mProjection;
+    // sprites use a simple view-projection (screen-space coordinates)
+    data.mSpriteViewProj = Matrix4::CreateSimpleViewProj(mScreenWidth, mScreenHeight);
+
     // camera position is from inverted view
     Matrix4 invView = mView;
     invView.Invert();
-    shader->SetVectorUniform("uCameraPos", invView.GetTranslation());
+    data.mCameraPos = invView.GetTranslation();
 
     // ambient light
-    shader->SetVectorUniform("uAmbientLight", mAmbientLight);
+    data.mAmbientLight = mAmbientLight;
 
     // directional light
-    shader->SetVectorUniform("uDirLight.mDirection", mDirLight.mDirection);
-    shader->SetVectorUniform("uDirLight.mDiffuseColor", mDirLight.mDiffuseColor);
-    shader->SetVectorUniform("uDirLight.mSpecColor", mDirLight.mSpecColor);
+    data.mDirLight.mDirection = mDirLight.mDirection;
+    data.mDirLight.mDiffuseColor = mDirLight.mDiffuseColor;
+    data.mDirLight.mSpecColor = mDirLight.mSpecColor;
+
+    // point lights
+    for (PointLight* light : mPointLights) {
+        if (static_cast<unsigned int>(data.mNumPointLights) == MaxPointLights) {
+            break;
+        }
+        GPUPointLight& gpuLight = data.mPointLights[data.mNumPointLights];
+        gpuLight.mPosition = light->mPosition;
+        gpuLight.mDiffuseColor = light->mDiffuseColor;
+        gpuLight.mSpecColor = light->mSpecColor;
+        gpuLight.mRadius = light->mRadius;
+        data.mNumPointLights += 1;
+    }
+
+    mFrameData->Update(&data);
 }
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <SDL/SDL.h>
 #include "Math.hpp"
 
@@ -14,13 +15,25 @@ struct DirectionalLight {
 	Vector3 mSpecColor;
 };
 
+struct PointLight {
+	// position of light (in world space)
+	Vector3 mPosition;
+	// diffuse color
+	Vector3 mDiffuseColor;
+	// specular color
+	Vector3 mSpecColor;
+	// distance at which the light has faded out completely
+	float mRadius;
+};
+
 class Renderer {
 public:
 	Renderer(class Game* game);
 	~Renderer();
 
 	// initialize and shutdown renderer
-	bool Initialize(float screenWidth, float screenHeight);
+	// (headless = null renderer: no window or GL context, meshes/textures aren't uploaded, Draw does nothing)
+	bool Initialize(float screenWidth, float screenHeight, bool headless = false);
 	void Shutdown();
 
 	// unload all textures/meshes
@@ -42,6 +55,15 @@ public:
 		mView = view;
 	}
 
+	// the camera that gets a chance to update the view right before drawing
+	class CameraComponent* GetCamera() const {
+		return mCamera;
+	}
+
+	void SetCamera(class CameraComponent* camera) {
+		mCamera = camera;
+	}
+
 	void SetAmbientLight(const Vector3& ambient) {
 		mAmbientLight = ambient;
 	}
@@ -50,6 +72,10 @@ public:
 		return mDirLight;
 	}
 
+	// point lights are owned by the caller (only the first MaxPointLights are drawn)
+	void AddPointLight(PointLight* light);
+	void RemovePointLight(PointLight* light);
+
 	float GetScreenWidth() const {
 		return mScreenWidth;
 	}
@@ -58,10 +84,20 @@ public:
 		return mScreenHeight;
 	}
 
+	bool IsHeadless() const {
+		return mHeadless;
+	}
+
+	// must match MAX_POINT_LIGHTS of the FrameData block in the shaders
+	static const unsigned int MaxPointLights = 4;
+	// uniform block binding point of the per-frame data
+	static const unsigned int FrameDataBinding = 0;
+
 private:
 	bool LoadShaders();
 	void CreateSpriteVerts();
-	void SetLightUniforms(class Shader* shader);
+	// write the camera and lighting data for this frame into the FrameData uniform buffer
+	void UpdateFrameData();
 
 private:
 	// map of textures loaded
@@ -84,6 +120,17 @@ private:
 
 	// mesh shader
 	class Shader* mMeshShader;
+	// mesh shader taking the world transform per instance
+	class Shader* mMeshInstancedShader;
+
+	// per-frame data (camera and lights) shared by every shader
+	class UniformBuffer* mFrameData;
+
+	// draws of the frame, sorted by state
+	class RenderQueue* mRenderQueue;
+
+	// active camera
+	class CameraComponent* mCamera;
 
 	// view/projection for 3D shaders
 	Matrix4 mView;
@@ -96,7 +143,11 @@ private:
 	// lighting data
 	Vector3 mAmbientLight;
 	DirectionalLight mDirLight;
+	std::vector<PointLight*> mPointLights;
 	
+	// true if running without a window/GL context
+	bool mHeadless;
+
 	// window
 	SDL_Window* mWindow;
 	
@@ -1,7 +1,9 @@
 #include "Shader.hpp"
 #include <fstream>
 #include <sstream>
+#include <cstring>
 #include "Texture.hpp"
+#include "Counters.hpp"
 
 Shader::Shader() {
 	mShaderProgram = 0;
@@ -17,38 +19,183 @@ void Shader::Unload() {
 	glDeleteProgram(mShaderProgram);
 	glDeleteShader(mVertexShader);
 	glDeleteShader(mFragShader);
+	mUniforms.clear();
+	mUniformNames.clear();
+	mUniformCache.clear();
 }
 
 // sets a shader program as the active one, which OpenGL will use when drawing triangles
 void Shader::SetActive() {
 	glUseProgram(mShaderProgram);
+	COUNTER_ADD("ShaderBinds", 1);
 }
 
-void Shader::SetMatrixUniform(const char* name, const Matrix4& matrix) {
+void Shader::SetMatrixUniform(UniformName name, const Matrix4& matrix) {
 	// "name" is the uniform variable's name in the shader file
 	// "matrix" is the custom matrix we assign to the uniform variable
 
 	// find the uniform by this name
-	GLuint loc = glGetUniformLocation(mShaderProgram, name);
+	Uniform* uniform = FindUniform(name);
+	if (!uniform || !UpdateCache(uniform, matrix.GetAsFloatPtr(), 16)) {
+		return;
+	}
+	COUNTER_ADD("UniformUploads", 1);
 	// send the matrix data to the uniform
 	glUniformMatrix4fv(
-		loc,  // uniform ID
+		uniform->mLocation,  // uniform ID
 		1,  // number of matrices (only 1 in this case)
 		GL_TRUE,  // set to TRUE if using row vectors
 		matrix.GetAsFloatPtr()  // pointer to matrix data
 	);
 }
 
-void Shader::SetVectorUniform(const char* name, const Vector3& vector) {
-	GLuint loc = glGetUniformLocation(mShaderProgram, name);
+void Shader::SetVectorUniform(UniformName name, const Vector3& vector) {
+	Uniform* uniform = FindUniform(name);
+	if (!uniform || !UpdateCache(uniform, vector.GetAsFloatPtr(), 3)) {
+		return;
+	}
+	COUNTER_ADD("UniformUploads", 1);
 	// send the vector data
-	glUniform3fv(loc, 1, vector.GetAsFloatPtr());
+	glUniform3fv(uniform->mLocation, 1, vector.GetAsFloatPtr());
 }
 
-void Shader::SetFloatUniform(const char* name, float value) {
-	GLuint loc = glGetUniformLocation(mShaderProgram, name);
+void Shader::SetFloatUniform(UniformName name, float value) {
+	Uniform* uniform = FindUniform(name);
+	if (!uniform || !UpdateCache(uniform, &value, 1)) {
+		return;
+	}
+	COUNTER_ADD("UniformUploads", 1);
 	// send the float data
-	glUniform1f(loc, value);
+	glUniform1f(uniform->mLocation, value);
+}
+
+bool Shader::BindUniformBlock(const char* name, unsigned int binding) {
+	GLuint index = glGetUniformBlockIndex(mShaderProgram, name);
+	if (index == GL_INVALID_INDEX) {
+		return false;
+	}
+	glUniformBlockBinding(mShaderProgram, index, binding);
+	return true;
+}
+
+Shader::Uniform* Shader::FindUniform(UniformName name) {
+	if (mUniforms.empty()) {
+		return nullptr;
+	}
+
+	// linear probing, the table is at most half full so a miss ends quickly on an empty slot
+	uint32_t mask = static_cast<uint32_t>(mUniforms.size()) - 1;
+	for (uint32_t i = name.mHash & mask; ; i = (i + 1) & mask) {
+		Uniform& uniform = mUniforms[i];
+		if (uniform.mLocation == -1) {
+			return nullptr;
+		}
+		if (uniform.mHash == name.mHash) {
+			return &uniform;
+		}
+	}
+}
+
+bool Shader::UpdateCache(Uniform* uniform, const float* value, uint32_t numFloats) {
+	// a setter of the wrong type for this uniform (it would also write past the uniform's cached value)
+	if (numFloats != uniform->mNumFloats) {
+		if (!uniform->mMismatchLogged) {
+			SDL_Log("Uniform %s set with %u floats, but it holds %u",
+				mUniformNames[uniform - mUniforms.data()].c_str(), numFloats, uniform->mNumFloats);
+			uniform->mMismatchLogged = true;
+		}
+		return false;
+	}
+	float* cached = mUniformCache.data() + uniform->mCacheOffset;
+	if (uniform->mCached && memcmp(cached, value, numFloats * sizeof(float)) == 0) {
+		COUNTER_ADD("UniformSkips", 1);
+		return false;
+	}
+	memcpy(cached, value, numFloats * sizeof(float));
+	uniform->mCached = true;
+	return true;
+}
+
+void Shader::LoadUniforms() {
+	mUniforms.clear();
+	mUniformNames.clear();
+	mUniformCache.clear();
+
+	GLint numActive = 0;
+	GLint maxNameLength = 0;
+	glGetProgramiv(mShaderProgram, GL_ACTIVE_UNIFORMS, &numActive);
+	glGetProgramiv(mShaderProgram, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+	// each element of an array is a uniform of its own (so first count them)
+	struct Active {
+		std::string mName;
+		GLint mLocation;
+		uint32_t mNumFloats;
+	};
+	std::vector<Active> active;
+	std::vector<char> buffer(maxNameLength + 1);
+	for (GLint i = 0; i < numActive; ++i) {
+		GLint size = 0;
+		GLenum type = GL_NONE;
+		glGetActiveUniform(mShaderProgram, i, static_cast<GLsizei>(buffer.size()), nullptr, &size, &type, buffer.data());
+		std::string name = buffer.data();
+
+		// only float types get a cached value (the setters don't cover the rest)
+		uint32_t numFloats = 0;
+		switch (type) {
+			case GL_FLOAT: numFloats = 1; break;
+			case GL_FLOAT_VEC2: numFloats = 2; break;
+			case GL_FLOAT_VEC3: numFloats = 3; break;
+			case GL_FLOAT_VEC4: numFloats = 4; break;
+			case GL_FLOAT_MAT4: numFloats = 16; break;
+			default: break;
+		}
+
+		if (size == 1) {
+			active.push_back({name, glGetUniformLocation(mShaderProgram, name.c_str()), numFloats});
+			continue;
+		}
+		// an array is reported as "name[0]", and can be set by "name" too
+		std::string base = name.substr(0, name.rfind('['));
+		for (GLint element = 0; element < size; ++element) {
+			std::string elementName = base + "[" + std::to_string(element) + "]";
+			active.push_back({elementName, glGetUniformLocation(mShaderProgram, elementName.c_str()), numFloats});
+		}
+		active.push_back({base, active[active.size() - size].mLocation, numFloats});
+	}
+
+	// at least twice as many slots as uniforms, a power of two
+	size_t tableSize = 8;
+	while (tableSize < active.size() * 2) {
+		tableSize *= 2;
+	}
+	mUniforms.resize(tableSize, Uniform{0, -1, 0, 0, false, false});
+	mUniformNames.resize(tableSize);
+
+	uint32_t mask = static_cast<uint32_t>(tableSize) - 1;
+	for (const Active& uniform : active) {
+		// names from glGetActiveUniform that can't be set (e.g. built-ins)
+		if (uniform.mLocation == -1) {
+			continue;
+		}
+
+		uint32_t hash = HashUniformName(uniform.mName.c_str());
+		uint32_t i = hash & mask;
+		while (mUniforms[i].mLocation != -1 && mUniforms[i].mHash != hash) {
+			i = (i + 1) & mask;
+		}
+		if (mUniforms[i].mLocation != -1) {
+			SDL_Log("Uniform %s has the same hash as another uniform of the program, it can't be set", uniform.mName.c_str());
+			continue;
+		}
+
+		mUniforms[i].mHash = hash;
+		mUniforms[i].mLocation = uniform.mLocation;
+		mUniforms[i].mCacheOffset = static_cast<uint32_t>(mUniformCache.size());
+		mUniforms[i].mNumFloats = uniform.mNumFloats;
+		mUniformNames[i] = uniform.mName;
+		mUniformCache.resize(mUniformCache.size() + uniform.mNumFloats);
+	}
 }
 
 // validate whether a shader program has linked its vertex and fragment shaders successfully
@@ -87,6 +234,9 @@ bool Shader::Load(const std::string& vertName, const std::string& fragName) {
 		return false;
 	}
 
+	// look up every uniform once here, so setting one never has to ask the driver
+	LoadUniforms();
+
 	return true;
 }
 
@@ -1,10 +1,34 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
 #include "GL/glew.h"
 #include "SDL/SDL.h"
 #include "Math.hpp"
 
+// FNV-1a hash of a uniform name (constexpr, so UNIFORM_NAME can hash literals at compile time)
+constexpr uint32_t HashUniformName(const char* name) {
+	uint32_t hash = 2166136261u;
+	for (; *name != '\0'; ++name) {
+		hash = (hash ^ static_cast<uint8_t>(*name)) * 16777619u;
+	}
+	return hash;
+}
+
+// the hash a uniform is looked up by (made with UNIFORM_NAME)
+struct UniformName {
+	constexpr explicit UniformName(uint32_t hash) : mHash(hash) {}
+
+	uint32_t mHash;
+};
+
+// name of a uniform for the Set*Uniform functions, e.g. SetFloatUniform(UNIFORM_NAME("uSpecPower"), 1.0f)
+// (a template argument has to be a constant expression, so the hash is always computed at compile time,
+// also in unoptimized builds)
+#define UNIFORM_NAME(name) UniformName(std::integral_constant<uint32_t, HashUniformName(name)>::value)
+
 // this class loads in shaders and lets OpenGL know about them
 // step 1: load and compile the vertex shader
 // step 2: load and compile the fragment shader
@@ -20,12 +44,20 @@ public:
 	void Unload();
 	// set this as the active shader program
 	void SetActive();
+
+	// OpenGL ID of the shader program
+	GLuint GetProgramID() const {
+		return mShaderProgram;
+	}
 	// set a matrix uniform
-	void SetMatrixUniform(const char* name, const Matrix4& matrix);
+	void SetMatrixUniform(UniformName name, const Matrix4& matrix);
 	// set a vector3 uniform
-	void SetVectorUniform(const char* name, const Vector3& vector);
+	void SetVectorUniform(UniformName name, const Vector3& vector);
 	// set a float uniform
-	void SetFloatUniform(const char* name, float value);
+	void SetFloatUniform(UniformName name, float value);
+	// read the uniform block with this name from the buffer attached to binding
+	// (returns false if the program doesn't have the block)
+	bool BindUniformBlock(const char* name, unsigned int binding);
 
 private:
 	// tries to compile the specified shader
@@ -35,9 +67,38 @@ private:
 	// tests whether vertex/fragment programs link
 	bool IsValidProgram();
 
+	// an active uniform of the program
+	struct Uniform {
+		uint32_t mHash;
+		// -1 for an empty slot of the table
+		GLint mLocation;
+		// where its last uploaded value starts in mUniformCache, and how many floats it holds
+		// (0 for types the setters don't cover, e.g. samplers)
+		uint32_t mCacheOffset;
+		uint32_t mNumFloats;
+		// false until the first upload, so that one always goes through
+		bool mCached;
+		// a setter of the wrong type was reported already (so it's logged once, not every draw)
+		bool mMismatchLogged;
+	};
+
+	// fill the uniform table with every active uniform of the linked program
+	void LoadUniforms();
+	// the table entry for a uniform, or nullptr if the program doesn't use it
+	Uniform* FindUniform(UniformName name);
+	// copy value into the uniform's cached value, returns false if it was already set to that
+	bool UpdateCache(Uniform* uniform, const float* value, uint32_t numFloats);
+
 private:
 	// store the shader object IDs
 	GLuint mVertexShader;
 	GLuint mFragShader;
 	GLuint mShaderProgram;
+
+	// active uniforms, in an open-addressed table keyed by name hash (size is a power of two)
+	std::vector<Uniform> mUniforms;
+	// name of each table entry (only for messages, so it's kept out of the table)
+	std::vector<std::string> mUniformNames;
+	// last value uploaded for each uniform (Uniform::mCacheOffset indexes into this)
+	std::vector<float> mUniformCache;
 };
\ No newline at end of file
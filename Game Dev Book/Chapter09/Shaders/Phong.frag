@@ -14,44 +14,67 @@ out vec4 outColor;  /* RGBA */
 /* create a uniform for texture sampler that can get the color from a texture given a texture coordinate */
 uniform sampler2D uTexture;
 
-/* create a struct for directional light */
+/* specular power for this surface */
+uniform float uSpecPower;
+
+/* per-frame data, shared by every shader through one uniform buffer (see Renderer::UpdateFrameData)
+   std140 fixes the memory layout, row_major matches the row vectors used here (and Matrix4's layout)
+   the block must be declared the same way in every shader that uses it */
+#define MAX_POINT_LIGHTS 4
 struct DirectionalLight {
-    // direction of light
     vec3 mDirection;
-    // diffuse color
     vec3 mDiffuseColor;
-    // specular color
     vec3 mSpecColor;
 };
+struct PointLight {
+    vec3 mPosition;
+    vec3 mDiffuseColor;
+    vec3 mSpecColor;
+    /* distance at which the light has faded out completely */
+    float mRadius;
+};
+layout(std140, row_major) uniform FrameData {
+    /* view-projection for 3D objects */
+    mat4 uViewProj;
+    /* view-projection for sprites */
+    mat4 uSpriteViewProj;
+    /* camera position (in world space) */
+    vec3 uCameraPos;
+    /* ambient light level */
+    vec3 uAmbientLight;
+    DirectionalLight uDirLight;
+    PointLight uPointLights[MAX_POINT_LIGHTS];
+    int uNumPointLights;
+};
 
-/* uniforms for lighting */
-/* camera position (in world space) */
-uniform vec3 uCameraPos;
-/* ambient light level */
-uniform vec3 uAmbientLight;
-/* specular power for this surface */
-uniform float uSpecPower;
-
-/* directional light */
-uniform DirectionalLight uDirLight;
+/* diffuse + specular from one light (L points from the surface to the light) */
+vec3 Phong(vec3 N, vec3 L, vec3 V, vec3 diffuseColor, vec3 specColor) {
+    /* reflection of -L about N */
+    vec3 R = normalize(reflect(-L, N));
+    float NdotL = dot(N, L);
+    if (NdotL > 0) {
+        vec3 diffuse = diffuseColor * NdotL;
+        vec3 specular = specColor * pow(max(0.0, dot(R, V)), uSpecPower);
+        return diffuse + specular;
+    }
+    return vec3(0.0);
+}
 
 void main() {
     /* surface normal */
     vec3 N = normalize(fragNormal);
-    /* vector from surface to light (negation of directional light's direction) */
-    vec3 L = normalize(-uDirLight.mDirection);
     /* vector from surface to camera */
     vec3 V = normalize(uCameraPos - fragWorldPos);
-    /* reflection of -L about N */
-    vec3 R = normalize(reflect(-L, N));
 
     /* compute phong reflection */
     vec3 phong = uAmbientLight;
-    float NdotL = dot(N, L);
-    if (NdotL > 0) {
-        vec3 diffuse = uDirLight.mDiffuseColor * NdotL;
-        vec3 specular = uDirLight.mSpecColor * pow(max(0.0, dot(R, V)), uSpecPower);
-        phong += diffuse + specular;
+    /* directional light (L is the negation of its direction) */
+    phong += Phong(N, normalize(-uDirLight.mDirection), V, uDirLight.mDiffuseColor, uDirLight.mSpecColor);
+    /* point lights, fading out linearly up to their radius */
+    for (int i = 0; i < uNumPointLights; ++i) {
+        vec3 toLight = uPointLights[i].mPosition - fragWorldPos;
+        float falloff = clamp(1.0 - length(toLight) / uPointLights[i].mRadius, 0.0, 1.0);
+        phong += falloff * Phong(N, normalize(toLight), V, uPointLights[i].mDiffuseColor, uPointLights[i].mSpecColor);
     }
 
     /* final color is texture color times phong light (alpha = 1) */
@@ -0,0 +1,67 @@
+/* request GLSL 3.3 */
+#version 330
+
+/* per-frame data, shared by every shader through one uniform buffer (see Renderer::UpdateFrameData)
+   std140 fixes the memory layout, row_major matches the row vectors used here (and Matrix4's layout)
+   the block must be declared the same way in every shader that uses it */
+#define MAX_POINT_LIGHTS 4
+struct DirectionalLight {
+    vec3 mDirection;
+    vec3 mDiffuseColor;
+    vec3 mSpecColor;
+};
+struct PointLight {
+    vec3 mPosition;
+    vec3 mDiffuseColor;
+    vec3 mSpecColor;
+    /* distance at which the light has faded out completely */
+    float mRadius;
+};
+layout(std140, row_major) uniform FrameData {
+    /* view-projection for 3D objects */
+    mat4 uViewProj;
+    /* view-projection for sprites */
+    mat4 uSpriteViewProj;
+    /* camera position (in world space) */
+    vec3 uCameraPos;
+    /* ambient light level */
+    vec3 uAmbientLight;
+    DirectionalLight uDirLight;
+    PointLight uPointLights[MAX_POINT_LIGHTS];
+    int uNumPointLights;
+};
+
+/* any vertex attributes go here */
+/* we must specify which attribute slot corresponds to which in variable since we now have multiple vertex attributes */
+layout(location=0) in vec3 inPosition;  /* the "location" value corresponds to the slot number in the glVertexAttribPointer call */
+layout(location=1) in vec3 inNormal;
+layout(location=2) in vec2 inTexCoord;
+/* world transform of this instance (a mat4 attribute takes locations 3-6), from the instance buffer
+   the buffer holds the rows of the matrix, which GLSL reads as columns, so this is the transpose of
+   uWorldTransform in Phong.vert: "inWorldTransform * v" here is "v * uWorldTransform" there */
+layout(location=3) in mat4 inWorldTransform;
+
+/* declare a global out variable to pass texture coord data from vertex shader to fragment shader (so frag shader can determine the color at each pixel) */
+out vec2 fragTexCoord;
+/* normal (in world space) */
+out vec3 fragNormal;
+/* position (in world space) */
+out vec3 fragWorldPos;
+
+void main() {
+    /* convert the 3D inPosition into homogeneous coordinates */
+    vec4 pos = vec4(inPosition, 1.0);  /* this position is in object space */
+    /* transform pos into world space by multiplying it by the world transform matrix */
+    pos = inWorldTransform * pos;
+    /* save world position */
+    fragWorldPos = pos.xyz;
+    /* transform world position into clip space by multiplying it by the view-projection matrix */
+    gl_Position = pos * uViewProj;
+
+    /* transform normal into world space (w = 0 because normal is not a position, so we want to
+       zero out the translation component of the world transform matrix in the multiplication) */
+    fragNormal = (inWorldTransform * vec4(inNormal, 0.0f)).xyz;
+
+    /* copy tex coord directly from input to output variable, to pass along the texture coord to frag shader */
+    fragTexCoord = inTexCoord;
+}
\ No newline at end of file
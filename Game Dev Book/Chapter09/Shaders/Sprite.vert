@@ -1,9 +1,38 @@
 /* request GLSL 3.3 */
 #version 330
 
-/* uniforms for world transform and view-proj */
+/* uniform for world transform */
 uniform mat4 uWorldTransform;  /* an "uniform" is a global variable that stays the same between numerous invocations of the shader program */
-uniform mat4 uViewProj;
+
+/* per-frame data, shared by every shader through one uniform buffer (see Renderer::UpdateFrameData)
+   std140 fixes the memory layout, row_major matches the row vectors used here (and Matrix4's layout)
+   the block must be declared the same way in every shader that uses it */
+#define MAX_POINT_LIGHTS 4
+struct DirectionalLight {
+    vec3 mDirection;
+    vec3 mDiffuseColor;
+    vec3 mSpecColor;
+};
+struct PointLight {
+    vec3 mPosition;
+    vec3 mDiffuseColor;
+    vec3 mSpecColor;
+    /* distance at which the light has faded out completely */
+    float mRadius;
+};
+layout(std140, row_major) uniform FrameData {
+    /* view-projection for 3D objects */
+    mat4 uViewProj;
+    /* view-projection for sprites */
+    mat4 uSpriteViewProj;
+    /* camera position (in world space) */
+    vec3 uCameraPos;
+    /* ambient light level */
+    vec3 uAmbientLight;
+    DirectionalLight uDirLight;
+    PointLight uPointLights[MAX_POINT_LIGHTS];
+    int uNumPointLights;
+};
 
 /* any vertex attributes go here */
 /* we must specify which attribute slot corresponds to which in variable since we now have multiple vertex attributes */
@@ -20,7 +49,7 @@ void main() {
     /* transform pos into world space by multiplying it by the world transform matrix */
     vec4 worldPos = pos * uWorldTransform;
     /* transform worldPos into clip space by multiplying it by the view-projection matrix */
-    gl_Position = worldPos * uViewProj;
+    gl_Position = worldPos * uSpriteViewProj;
 
     /* copy tex coord directly from input to output variable, to pass along the texture coord to frag shader */
     fragTexCoord = inTexCoord;
@@ -4,6 +4,7 @@
 #include "Shader.hpp"
 #include "Renderer.hpp"
 #include "Texture.hpp"
+#include "RenderQueue.hpp"
 
 SpriteComponent::SpriteComponent(Actor* owner, int drawOrder) : Component(owner) {
 	mDrawOrder = drawOrder;
@@ -31,27 +32,21 @@ void SpriteComponent::SetTexture(Texture* texture) {
 	mTexHeight = mTexture->GetHeight();
 }
 
-void SpriteComponent::Draw(Shader* shader) {
+void SpriteComponent::Submit(RenderQueue* queue, Shader* shader, VertexArray* spriteVerts) {
 	if (mTexture) {
+		RenderQueue::DrawCommand command;
+		command.mShader = shader;
+		// sprites are drawn in draw order, never batched
+		command.mInstancedShader = nullptr;
+		command.mTexture = mTexture;
+		command.mVertexArray = spriteVerts;
 		// scale the quad by the width/height of texture
 		Matrix4 scaleMat = Matrix4::CreateScale(
 			static_cast<float>(mTexWidth),
 			static_cast<float>(mTexHeight),
 			1.0f);
-		Matrix4 world = scaleMat * mOwner->GetWorldTransform();  // so that if the actor has scale 2.0f and texture has size 128x128, the resulting world transform has size 256x256
-
-		// set world transform
-		shader->SetMatrixUniform("uWorldTransform", world);
-
-		// set current active texture
-		mTexture->SetActive();
-
-		// draw a quad
-		glDrawElements(
-			GL_TRIANGLES,  // type of polygon/primitive to draw
-			6,  // number of indices in index buffer
-			GL_UNSIGNED_INT,  // type of each index
-			nullptr  // usually nullptr
-		);
+		command.mWorldTransform = scaleMat * mOwner->GetRenderTransform();  // so that if the actor has scale 2.0f and texture has size 128x128, the resulting world transform has size 256x256
+		command.mSpecPower = 0.0f;
+		queue->SubmitTranslucent(command, mDrawOrder);
 	}
 }
@@ -3,12 +3,20 @@
 #include "Component.hpp"
 
 class SpriteComponent : public Component {
+	DECLARE_COMPONENT_TYPE(SpriteComponent, Component)
+
 public:
 	// lower draw order corresponds with further back
 	SpriteComponent(class Actor* owner, int drawOrder = 100);
 	~SpriteComponent();
 
-	virtual void Draw(class Shader* shader);
+	// only drawn/queried, never updated
+	bool NeedsUpdate() const override {
+		return false;
+	}
+
+	// queue this sprite to be drawn with the given shader and (sprite quad) vertex array
+	virtual void Submit(class RenderQueue* queue, class Shader* shader, class VertexArray* spriteVerts);
 	virtual void SetTexture(class Texture* texture);
 
 	int GetDrawOrder() const {
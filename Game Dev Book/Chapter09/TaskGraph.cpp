@@ -0,0 +1,324 @@
+#include "TaskGraph.hpp"
+#include "Profiler.hpp"
+#include "Counters.hpp"
+#include "SDL/SDL.h"
+#include <string>
+
+TaskGraph::TaskGraph(size_t numWorkers) {
+	mNumPending = 0;
+	mParallelRun = false;
+	mRemaining = 0;
+	mQueuedAny = 0;
+	mQueuedMain = 0;
+	mRunId = 0;
+	mShutdown = false;
+	mWallTime = 0.0;
+	mCriticalPathTime = 0.0;
+	mNumRuns = 0;
+	mTotalWallTime = 0.0;
+	mTotalCriticalPathTime = 0.0;
+	mTotalWorkTime = 0.0;
+
+	mQueues.reset(new WorkQueue[numWorkers + 1]);
+	for (size_t i = 0; i < numWorkers; ++i) {
+		mWorkers.emplace_back(&TaskGraph::WorkerLoop, this, i + 1);
+	}
+}
+
+TaskGraph::~TaskGraph() {
+	{
+		std::lock_guard<std::mutex> lock(mWaitMutex);
+		mShutdown = true;
+	}
+	mWaitCV.notify_all();
+
+	for (auto& worker : mWorkers) {
+		worker.join();
+	}
+}
+
+TaskGraph::TaskId TaskGraph::AddTask(const char* name, const std::function<void()>& func,
+	std::initializer_list<TaskId> dependencies, Affinity affinity) {
+	TaskId id = static_cast<TaskId>(mTasks.size());
+
+	Task task;
+	task.mName = name;
+	task.mFunc = func;
+	task.mAffinity = affinity;
+	task.mStart = 0.0;
+	task.mEnd = 0.0;
+	task.mThread = 0;
+	task.mTotalTime = 0.0;
+	task.mMaxTime = 0.0;
+	for (TaskId dependency : dependencies) {
+		if (dependency >= id) {
+			SDL_Log("Task %s depends on a task that isn't in the graph yet", name);
+			continue;
+		}
+		task.mDependencies.emplace_back(dependency);
+		mTasks[dependency].mDependents.emplace_back(id);
+	}
+	mTasks.emplace_back(task);
+
+	return id;
+}
+
+void TaskGraph::Run(bool parallel) {
+	if (mTasks.empty()) {
+		return;
+	}
+	mRunStart = std::chrono::steady_clock::now();
+	mParallelRun = parallel && !mWorkers.empty();
+
+	if (!mParallelRun) {
+		// tasks are in dependency order already
+		for (TaskId id = 0; id < mTasks.size(); ++id) {
+			mRemaining += 1;
+			Execute(0, id);
+		}
+		FinishRun();
+		return;
+	}
+
+	if (mNumPending != mTasks.size()) {
+		mPending.reset(new std::atomic<uint32_t>[mTasks.size()]);
+		mNumPending = mTasks.size();
+	}
+	for (size_t i = 0; i < mTasks.size(); ++i) {
+		mPending[i] = static_cast<uint32_t>(mTasks[i].mDependencies.size());
+	}
+	mRemaining = static_cast<uint32_t>(mTasks.size());
+
+	// queue the tasks without dependencies, then wake the workers
+	for (TaskId id = 0; id < mTasks.size(); ++id) {
+		if (mTasks[id].mDependencies.empty()) {
+			Push(0, id);
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(mWaitMutex);
+		mRunId += 1;
+	}
+	mWaitCV.notify_all();
+
+	RunTasks(0);
+	FinishRun();
+}
+
+double TaskGraph::GetTaskTime(TaskId id) const {
+	return id < mTasks.size() ? mTasks[id].mEnd - mTasks[id].mStart : 0.0;
+}
+
+void TaskGraph::LogTimings() {
+	if (mNumRuns == 0) {
+		return;
+	}
+
+	SDL_Log("Task graph over %u runs (ms, avg / max / thread of last run):", mNumRuns);
+	for (auto& task : mTasks) {
+		SDL_Log("  %-20s %8.3f %8.3f   %zu", task.mName, task.mTotalTime * 1000.0 / mNumRuns,
+			task.mMaxTime * 1000.0, task.mThread);
+	}
+	SDL_Log("  wall %.3f, critical path %.3f, total work %.3f", mTotalWallTime * 1000.0 / mNumRuns,
+		mTotalCriticalPathTime * 1000.0 / mNumRuns, mTotalWorkTime * 1000.0 / mNumRuns);
+
+	std::string path;
+	for (TaskId id : mCriticalPath) {
+		if (!path.empty()) {
+			path += " > ";
+		}
+		path += mTasks[id].mName;
+	}
+	SDL_Log("  last critical path: %s", path.c_str());
+
+	for (auto& task : mTasks) {
+		task.mTotalTime = 0.0;
+		task.mMaxTime = 0.0;
+	}
+	mNumRuns = 0;
+	mTotalWallTime = 0.0;
+	mTotalCriticalPathTime = 0.0;
+	mTotalWorkTime = 0.0;
+}
+
+void TaskGraph::WorkerLoop(size_t threadIndex) {
+	uint64_t lastRunId = 0;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mWaitMutex);
+			mWaitCV.wait(lock, [this, lastRunId] { return mShutdown || mRunId != lastRunId; });
+			if (mShutdown) {
+				return;
+			}
+			lastRunId = mRunId;
+		}
+
+		RunTasks(threadIndex);
+	}
+}
+
+void TaskGraph::RunTasks(size_t threadIndex) {
+	while (mRemaining.load() > 0) {
+		TaskId id = 0;
+		if (FindTask(threadIndex, id)) {
+			Execute(threadIndex, id);
+			continue;
+		}
+
+		// nothing we can take right now, sleep until something is queued (or the run is over)
+		std::unique_lock<std::mutex> lock(mWaitMutex);
+		mWaitCV.wait(lock, [this, threadIndex] {
+			return mRemaining.load() == 0 || mShutdown || mQueuedAny.load() > 0 ||
+				(threadIndex == 0 && mQueuedMain.load() > 0);
+		});
+		if (mShutdown) {
+			return;
+		}
+	}
+}
+
+bool TaskGraph::FindTask(size_t threadIndex, TaskId& id) {
+	// main thread tasks first, they can't go anywhere else
+	if (threadIndex == 0 && mQueuedMain.load() > 0) {
+		std::lock_guard<std::mutex> lock(mMainQueue.mMutex);
+		if (!mMainQueue.mTasks.empty()) {
+			id = mMainQueue.mTasks.front();
+			mMainQueue.mTasks.pop_front();
+			mQueuedMain -= 1;
+			return true;
+		}
+	}
+
+	// newest task of our own
+	{
+		WorkQueue& queue = mQueues[threadIndex];
+		std::lock_guard<std::mutex> lock(queue.mMutex);
+		if (!queue.mTasks.empty()) {
+			id = queue.mTasks.back();
+			queue.mTasks.pop_back();
+			mQueuedAny -= 1;
+			return true;
+		}
+	}
+
+	// steal the oldest task of someone else
+	size_t numThreads = mWorkers.size() + 1;
+	for (size_t i = 1; i < numThreads; ++i) {
+		WorkQueue& queue = mQueues[(threadIndex + i) % numThreads];
+		std::lock_guard<std::mutex> lock(queue.mMutex);
+		if (!queue.mTasks.empty()) {
+			id = queue.mTasks.front();
+			queue.mTasks.pop_front();
+			mQueuedAny -= 1;
+			return true;
+		}
+	}
+	return false;
+}
+
+void TaskGraph::Execute(size_t threadIndex, TaskId id) {
+	Task& task = mTasks[id];
+
+	task.mThread = threadIndex;
+	task.mStart = GetSeconds();
+	{
+		PROFILE_SCOPE(task.mName);
+		task.mFunc();
+	}
+	task.mEnd = GetSeconds();
+
+	// queue the tasks this one was the last dependency of (only when running in parallel)
+	if (mParallelRun) {
+		for (TaskId dependent : task.mDependents) {
+			if (mPending[dependent].fetch_sub(1) == 1) {
+				Push(threadIndex, dependent);
+			}
+		}
+	}
+
+	if (mRemaining.fetch_sub(1) == 1) {
+		// last task, let everyone know the run is over
+		{
+			std::lock_guard<std::mutex> lock(mWaitMutex);
+		}
+		mWaitCV.notify_all();
+	}
+}
+
+void TaskGraph::Push(size_t threadIndex, TaskId id) {
+	if (mTasks[id].mAffinity == EMainThread) {
+		std::lock_guard<std::mutex> lock(mMainQueue.mMutex);
+		mMainQueue.mTasks.emplace_back(id);
+		mQueuedMain += 1;
+	}
+	else {
+		WorkQueue& queue = mQueues[threadIndex];
+		std::lock_guard<std::mutex> lock(queue.mMutex);
+		queue.mTasks.emplace_back(id);
+		mQueuedAny += 1;
+	}
+
+	// take the lock so a thread that just found nothing can't miss this
+	{
+		std::lock_guard<std::mutex> lock(mWaitMutex);
+	}
+	mWaitCV.notify_all();
+}
+
+void TaskGraph::FinishRun() {
+	mWallTime = GetSeconds();
+
+	// longest chain ending at each task (tasks are in dependency order)
+	std::vector<double> pathTime(mTasks.size());
+	std::vector<TaskId> pathPrev(mTasks.size());
+	TaskId last = 0;
+	double workTime = 0.0;
+	for (TaskId id = 0; id < mTasks.size(); ++id) {
+		Task& task = mTasks[id];
+		double time = task.mEnd - task.mStart;
+		workTime += time;
+		task.mTotalTime += time;
+		if (time > task.mMaxTime) {
+			task.mMaxTime = time;
+		}
+
+		pathTime[id] = time;
+		pathPrev[id] = id;
+		for (TaskId dependency : task.mDependencies) {
+			if (pathTime[dependency] + time > pathTime[id]) {
+				pathTime[id] = pathTime[dependency] + time;
+				pathPrev[id] = dependency;
+			}
+		}
+		if (pathTime[id] > pathTime[last]) {
+			last = id;
+		}
+	}
+	mCriticalPathTime = pathTime[last];
+
+	// walk the chain back from its end
+	mCriticalPath.clear();
+	TaskId id = last;
+	while (true) {
+		mCriticalPath.insert(mCriticalPath.begin(), id);
+		if (pathPrev[id] == id) {
+			break;
+		}
+		id = pathPrev[id];
+	}
+
+	mNumRuns += 1;
+	mTotalWallTime += mWallTime;
+	mTotalCriticalPathTime += mCriticalPathTime;
+	mTotalWorkTime += workTime;
+
+	// the gap between work and wall time is how much overlapped
+	COUNTER_ADD("TaskGraphWallUs", static_cast<int64_t>(mWallTime * 1000000.0));
+	COUNTER_ADD("TaskGraphCriticalPathUs", static_cast<int64_t>(mCriticalPathTime * 1000000.0));
+	COUNTER_ADD("TaskGraphWorkUs", static_cast<int64_t>(workTime * 1000000.0));
+}
+
+double TaskGraph::GetSeconds() const {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - mRunStart).count();
+}
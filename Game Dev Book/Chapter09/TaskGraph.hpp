@@ -0,0 +1,126 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+
+// declarative per-frame task graph, run on a small work-stealing pool
+// - tasks and their dependencies are added once, then Run executes the whole graph and returns once every
+//   task is done (the calling thread works too)
+// - a task is queued when its last dependency finishes, on the deque of the thread that finished it;
+//   threads take their own newest task first and steal the oldest task of another thread when they run out
+// - EMainThread tasks (SDL/GL calls, anything that uses the WorkerPool) only run on the thread calling Run
+// - every task is timed, and after each run the critical path (the longest chain of dependent tasks) is
+//   worked out, so it shows how much of the frame overlaps and what is holding it up
+// NOTE: Run must only be called from the thread that created the graph, and tasks can't be added while it runs
+class TaskGraph {
+public:
+	typedef uint32_t TaskId;
+
+	enum Affinity {
+		EAnyThread,
+		EMainThread
+	};
+
+	// numWorkers threads besides the one calling Run
+	TaskGraph(size_t numWorkers = 2);
+	~TaskGraph();
+
+	// dependencies must already be in the graph (so tasks are always in dependency order)
+	TaskId AddTask(const char* name, const std::function<void()>& func,
+		std::initializer_list<TaskId> dependencies = {}, Affinity affinity = EAnyThread);
+
+	// run every task once (parallel = false runs them in order on the calling thread, for comparison)
+	void Run(bool parallel = true);
+
+	// timings of the last run, in seconds
+	double GetTaskTime(TaskId id) const;
+	double GetWallTime() const {
+		return mWallTime;
+	}
+	double GetCriticalPathTime() const {
+		return mCriticalPathTime;
+	}
+
+	// log per-task average/max and the critical path since the last call, then start over
+	void LogTimings();
+
+private:
+	struct Task {
+		const char* mName;
+		std::function<void()> mFunc;
+		std::vector<TaskId> mDependencies;
+		std::vector<TaskId> mDependents;
+		Affinity mAffinity;
+
+		// last run (seconds since the start of Run)
+		double mStart;
+		double mEnd;
+		size_t mThread;
+		// statistics since the last LogTimings
+		double mTotalTime;
+		double mMaxTime;
+	};
+
+	// a thread's deque (the owner pushes and pops at the back, thieves take from the front)
+	struct WorkQueue {
+		std::mutex mMutex;
+		std::deque<TaskId> mTasks;
+	};
+
+	void WorkerLoop(size_t threadIndex);
+	// run tasks until the whole graph is done
+	void RunTasks(size_t threadIndex);
+	bool FindTask(size_t threadIndex, TaskId& id);
+	void Execute(size_t threadIndex, TaskId id);
+	void Push(size_t threadIndex, TaskId id);
+	// fills in the critical path and statistics of the last run
+	void FinishRun();
+
+	double GetSeconds() const;
+
+	std::vector<Task> mTasks;
+	// dependencies left per task in the current run
+	std::unique_ptr<std::atomic<uint32_t>[]> mPending;
+	size_t mNumPending;
+	// is the current run parallel (dependents are queued as they become ready)
+	bool mParallelRun;
+
+	std::vector<std::thread> mWorkers;
+	// one per thread (index 0 is the thread calling Run)
+	std::unique_ptr<WorkQueue[]> mQueues;
+	// EMainThread tasks, only taken by thread 0
+	WorkQueue mMainQueue;
+
+	std::mutex mWaitMutex;
+	// signalled when a run starts, a task is queued, the run finishes or on shutdown
+	std::condition_variable mWaitCV;
+	// tasks not finished yet in the current run
+	std::atomic<uint32_t> mRemaining;
+	// queued tasks any thread can take, and ones only the main thread can
+	std::atomic<uint32_t> mQueuedAny;
+	std::atomic<uint32_t> mQueuedMain;
+	// bumped for every run, so workers can tell a new run from a spurious wakeup
+	uint64_t mRunId;
+	bool mShutdown;
+
+	std::chrono::steady_clock::time_point mRunStart;
+	double mWallTime;
+	double mCriticalPathTime;
+	// tasks on the last critical path, first to last
+	std::vector<TaskId> mCriticalPath;
+
+	// statistics since the last LogTimings
+	uint32_t mNumRuns;
+	double mTotalWallTime;
+	double mTotalCriticalPathTime;
+	double mTotalWorkTime;
+};
@@ -2,11 +2,14 @@
 #include "SDL/SDL.h"
 #include "GL/glew.h"
 #include "SOIL/SOIL.h"
+#include "Counters.hpp"
+#include "MemoryTracker.hpp"
 
 Texture::Texture() {
 	mWidth = 0;
 	mHeight = 0;
 	mTextureID = 0;
+	mBytes = 0;
 }
 
 Texture::~Texture() {
@@ -56,6 +59,10 @@ bool Texture::Load(const std::string& fileName) {
 	// tell SOIL to free the image from memory
 	SOIL_free_image_data(image);
 
+	// the texture now lives on the GPU (8 bits per channel, ignoring driver overhead)
+	mBytes = static_cast<int64_t>(mWidth) * mHeight * (channels == 4 ? 4 : 3);
+	MemoryTracker::AddExternal(MemoryTracker::ETexture, mBytes);
+
 	// enable bilinear filtering
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -64,10 +71,16 @@ bool Texture::Load(const std::string& fileName) {
 }
 
 void Texture::Unload() {
-	// delete texture object
-	glDeleteTextures(1, &mTextureID);
+	// delete texture object (a headless placeholder never created one)
+	if (mTextureID != 0) {
+		glDeleteTextures(1, &mTextureID);
+		mTextureID = 0;
+		MemoryTracker::RemoveExternal(MemoryTracker::ETexture, mBytes);
+		mBytes = 0;
+	}
 }
 
 void Texture::SetActive() {
 	glBindTexture(GL_TEXTURE_2D, mTextureID);
+	COUNTER_ADD("TextureBinds", 1);
 }
\ No newline at end of file
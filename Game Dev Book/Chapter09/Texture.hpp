@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 
 class Texture {
 public:
@@ -14,6 +15,7 @@ public:
 
 	int GetWidth() const { return mWidth; }
 	int GetHeight() const { return mHeight; }
+	unsigned int GetTextureID() const { return mTextureID; }
 
 private:
 	// OpenGL ID of this texture
@@ -21,4 +23,6 @@ private:
 	// width/height of the texture
 	int mWidth;
 	int mHeight;
+	// GPU memory of the texture (reported to the MemoryTracker)
+	int64_t mBytes;
 };
@@ -0,0 +1,488 @@
+#include "TransformStore.hpp"
+#include "Actor.hpp"
+#include <xmmintrin.h>
+#include <cstring>
+#include <algorithm>
+
+const size_t TransformStore::NoParent;
+
+TransformStore::TransformStore() {
+	mCount = 0;
+	mCapacity = 0;
+	mChildrenDirty = false;
+}
+
+TransformStore::~TransformStore() {
+}
+
+size_t TransformStore::Add(Actor* owner) {
+	Reserve(mCount + 1);
+
+	size_t index = mCount;
+	mCount += 1;
+
+	// start out as identity, and dirty so the first pass computes the world matrix
+	mPosX[index] = mPosY[index] = mPosZ[index] = 0.0f;
+	mRotX[index] = mRotY[index] = mRotZ[index] = 0.0f;
+	mRotW[index] = 1.0f;
+	mScale[index] = 1.0f;
+	mPrevPosX[index] = mPrevPosY[index] = mPrevPosZ[index] = 0.0f;
+	mPrevRotX[index] = mPrevRotY[index] = mPrevRotZ[index] = 0.0f;
+	mPrevRotW[index] = 1.0f;
+	mPrevScale[index] = 1.0f;
+	mWorld[index] = Matrix4::Identity;
+	mParents[index] = NoParent;
+	mOwners[index] = owner;
+
+	mMoved[index / 64] &= ~(1ull << (index % 64));
+	mAdded[index / 64] |= 1ull << (index % 64);
+	MarkDirty(index);
+
+	return index;
+}
+
+void TransformStore::Remove(size_t index) {
+	// unhook the transform from the hierarchy first
+	// (its children become roots where they are, their position/rotation/scale turned into world values)
+	if (!mChildren.empty()) {
+		Quaternion parentRot = ComputeWorldRotation(index);
+		float parentScale = ComputeWorldScale(index);
+		for (const auto& child : mChildren) {
+			if (mParents[child.mIndex] == index) {
+				SetPosition(child.mIndex, mWorld[child.mIndex].GetTranslation());
+				SetRotation(child.mIndex, Quaternion::Concatenate(GetRotation(child.mIndex), parentRot));
+				SetScale(child.mIndex, mScale[child.mIndex] * parentScale);
+				mParents[child.mIndex] = NoParent;
+				// the previous state is in the parent's space, don't blend from it
+				SaveState(child.mIndex);
+			}
+		}
+		mParents[index] = NoParent;
+		mChildren.erase(std::remove_if(mChildren.begin(), mChildren.end(),
+			[this](const Child& child) { return mParents[child.mIndex] == NoParent; }), mChildren.end());
+		mChildrenDirty = true;
+	}
+
+	size_t last = mCount - 1;
+	if (index != last) {
+		// move the last transform into the freed index (avoid shifting everything down)
+		mPosX[index] = mPosX[last];
+		mPosY[index] = mPosY[last];
+		mPosZ[index] = mPosZ[last];
+		mRotX[index] = mRotX[last];
+		mRotY[index] = mRotY[last];
+		mRotZ[index] = mRotZ[last];
+		mRotW[index] = mRotW[last];
+		mScale[index] = mScale[last];
+		mWorld[index] = mWorld[last];
+		mLocal[index] = mLocal[last];
+		mParents[index] = mParents[last];
+		mPrevPosX[index] = mPrevPosX[last];
+		mPrevPosY[index] = mPrevPosY[last];
+		mPrevPosZ[index] = mPrevPosZ[last];
+		mPrevRotX[index] = mPrevRotX[last];
+		mPrevRotY[index] = mPrevRotY[last];
+		mPrevRotZ[index] = mPrevRotZ[last];
+		mPrevRotW[index] = mPrevRotW[last];
+		mPrevScale[index] = mPrevScale[last];
+		mRenderPosX[index] = mRenderPosX[last];
+		mRenderPosY[index] = mRenderPosY[last];
+		mRenderPosZ[index] = mRenderPosZ[last];
+		mRenderRotX[index] = mRenderRotX[last];
+		mRenderRotY[index] = mRenderRotY[last];
+		mRenderRotZ[index] = mRenderRotZ[last];
+		mRenderRotW[index] = mRenderRotW[last];
+		mRenderScale[index] = mRenderScale[last];
+		mRender[index] = mRender[last];
+
+		// carry the dirty/moved bits along
+		uint64_t bit = 1ull << (index % 64);
+		uint64_t lastBit = 1ull << (last % 64);
+		if (mDirty[last / 64].load(std::memory_order_relaxed) & lastBit) {
+			mDirty[index / 64].fetch_or(bit, std::memory_order_relaxed);
+		}
+		else {
+			mDirty[index / 64].fetch_and(~bit, std::memory_order_relaxed);
+		}
+		mMoved[index / 64] = (mMoved[last / 64] & lastBit) ? (mMoved[index / 64] | bit) : (mMoved[index / 64] & ~bit);
+		mAdded[index / 64] = (mAdded[last / 64] & lastBit) ? (mAdded[index / 64] | bit) : (mAdded[index / 64] & ~bit);
+
+		// let the moved transform's owner know its new index
+		mOwners[index] = mOwners[last];
+		mOwners[index]->mTransformIndex = index;
+
+		// and the hierarchy (order doesn't change, only the index)
+		for (auto& child : mChildren) {
+			if (child.mIndex == last) {
+				child.mIndex = index;
+			}
+			if (mParents[child.mIndex] == last) {
+				mParents[child.mIndex] = index;
+			}
+		}
+	}
+
+	// reset the freed slot back to identity padding, so SIMD passes over it stay harmless
+	mPosX[last] = mPosY[last] = mPosZ[last] = 0.0f;
+	mRotX[last] = mRotY[last] = mRotZ[last] = 0.0f;
+	mRotW[last] = 1.0f;
+	mScale[last] = 1.0f;
+	mParents[last] = NoParent;
+	mDirty[last / 64].fetch_and(~(1ull << (last % 64)), std::memory_order_relaxed);
+	mMoved[last / 64] &= ~(1ull << (last % 64));
+	mAdded[last / 64] &= ~(1ull << (last % 64));
+	mOwners[last] = nullptr;
+
+	mCount -= 1;
+}
+
+Quaternion TransformStore::ComputeWorldRotation(size_t index) const {
+	Quaternion rot = GetRotation(index);
+	for (size_t p = mParents[index]; p != NoParent; p = mParents[p]) {
+		rot = Quaternion::Concatenate(rot, GetRotation(p));
+	}
+	return rot;
+}
+
+float TransformStore::ComputeWorldScale(size_t index) const {
+	float scale = mScale[index];
+	for (size_t p = mParents[index]; p != NoParent; p = mParents[p]) {
+		scale *= mScale[p];
+	}
+	return scale;
+}
+
+void TransformStore::Reserve(size_t count) {
+	if (count <= mCapacity) {
+		return;
+	}
+
+	// grow by doubling, in whole 64-transform blocks so every dirty word maps to full SIMD groups
+	size_t newCapacity = mCapacity > 0 ? mCapacity * 2 : 256;
+	while (newCapacity < count) {
+		newCapacity *= 2;
+	}
+
+	// padding entries are identity
+	mPosX.resize(newCapacity, 0.0f);
+	mPosY.resize(newCapacity, 0.0f);
+	mPosZ.resize(newCapacity, 0.0f);
+	mRotX.resize(newCapacity, 0.0f);
+	mRotY.resize(newCapacity, 0.0f);
+	mRotZ.resize(newCapacity, 0.0f);
+	mRotW.resize(newCapacity, 1.0f);
+	mScale.resize(newCapacity, 1.0f);
+	mWorld.resize(newCapacity);
+	mLocal.resize(newCapacity);
+	mParents.resize(newCapacity, NoParent);
+
+	mPrevPosX.resize(newCapacity, 0.0f);
+	mPrevPosY.resize(newCapacity, 0.0f);
+	mPrevPosZ.resize(newCapacity, 0.0f);
+	mPrevRotX.resize(newCapacity, 0.0f);
+	mPrevRotY.resize(newCapacity, 0.0f);
+	mPrevRotZ.resize(newCapacity, 0.0f);
+	mPrevRotW.resize(newCapacity, 1.0f);
+	mPrevScale.resize(newCapacity, 1.0f);
+
+	mRenderPosX.resize(newCapacity, 0.0f);
+	mRenderPosY.resize(newCapacity, 0.0f);
+	mRenderPosZ.resize(newCapacity, 0.0f);
+	mRenderRotX.resize(newCapacity, 0.0f);
+	mRenderRotY.resize(newCapacity, 0.0f);
+	mRenderRotZ.resize(newCapacity, 0.0f);
+	mRenderRotW.resize(newCapacity, 1.0f);
+	mRenderScale.resize(newCapacity, 1.0f);
+	mRender.resize(newCapacity);
+
+	std::unique_ptr<std::atomic<uint64_t>[]> dirty(new std::atomic<uint64_t>[newCapacity / 64]);
+	for (size_t i = 0; i < newCapacity / 64; ++i) {
+		dirty[i].store(i < mCapacity / 64 ? mDirty[i].load(std::memory_order_relaxed) : 0, std::memory_order_relaxed);
+	}
+	mDirty = std::move(dirty);
+	mMoved.resize(newCapacity / 64, 0);
+	mAdded.resize(newCapacity / 64, 0);
+	mChanged.resize(newCapacity / 64, 0);
+	mRecomputed.resize(newCapacity / 64, 0);
+	mOwners.resize(newCapacity, nullptr);
+	mUpdated.reserve(newCapacity);
+
+	mCapacity = newCapacity;
+}
+
+bool TransformStore::SetParent(size_t index, size_t parent) {
+	// can't attach to itself or to one of its own descendants
+	for (size_t p = parent; p != NoParent; p = mParents[p]) {
+		if (p == index) {
+			return false;
+		}
+	}
+
+	size_t oldParent = mParents[index];
+	if (oldParent == parent) {
+		return true;
+	}
+
+	if (oldParent == NoParent) {
+		Child child;
+		child.mIndex = index;
+		child.mDepth = 0;
+		mChildren.emplace_back(child);
+	}
+	else if (parent == NoParent) {
+		mChildren.erase(std::remove_if(mChildren.begin(), mChildren.end(),
+			[index](const Child& child) { return child.mIndex == index; }), mChildren.end());
+	}
+
+	mParents[index] = parent;
+	mChildrenDirty = true;
+	MarkDirty(index);
+	return true;
+}
+
+uint32_t TransformStore::ComputeDepth(size_t index) const {
+	uint32_t depth = 0;
+	for (size_t p = mParents[index]; p != NoParent; p = mParents[p]) {
+		depth += 1;
+	}
+	return depth;
+}
+
+void TransformStore::SortChildren() {
+	for (auto& child : mChildren) {
+		child.mDepth = ComputeDepth(child.mIndex);
+	}
+	std::stable_sort(mChildren.begin(), mChildren.end(),
+		[](const Child& a, const Child& b) { return a.mDepth < b.mDepth; });
+	mChildrenDirty = false;
+}
+
+void TransformStore::ComputeWorldTransforms() {
+	mUpdated.clear();
+
+	const size_t numWords = (mCount + 63) / 64;
+	for (size_t word = 0; word < numWords; ++word) {
+		uint64_t dirty = mDirty[word].load(std::memory_order_relaxed);
+		mChanged[word] = dirty;
+		mRecomputed[word] = 0;
+		if (dirty == 0) {
+			continue;
+		}
+
+		// rebuild every group of 4 transforms that has at least one dirty transform
+		// (recomputing a clean transform just reproduces the same matrix)
+		// for children this is the local matrix, the hierarchy pass below turns it into the world matrix
+		for (size_t group = 0; group < 16; ++group) {
+			if (((dirty >> (group * 4)) & 0xF) != 0) {
+				ComputeMatrices4(mPosX.data(), mPosY.data(), mPosZ.data(),
+					mRotX.data(), mRotY.data(), mRotZ.data(), mRotW.data(),
+					mScale.data(), word * 64 + group * 4, mWorld.data());
+				mRecomputed[word] |= 0xFull << (group * 4);
+			}
+		}
+
+		// remember which transforms changed, for render interpolation
+		// (new transforms have nothing to blend from, so they start out at their current state)
+		uint64_t added = mAdded[word];
+		mMoved[word] |= dirty & ~added;
+		while (added != 0) {
+			size_t bit = 0;
+			while (((added >> bit) & 1ull) == 0) {
+				bit += 1;
+			}
+			added &= added - 1;
+			SaveState(word * 64 + bit);
+		}
+		mAdded[word] = 0;
+
+		mDirty[word].store(0, std::memory_order_relaxed);
+	}
+
+	// children, parents first: only the ones whose own transform or parent's world matrix changed
+	// (a child in a recomputed SIMD group had its slot overwritten with its local matrix, so it's rebuilt too)
+	if (mChildrenDirty) {
+		SortChildren();
+	}
+	for (const auto& child : mChildren) {
+		size_t index = child.mIndex;
+		size_t parent = mParents[index];
+		bool recomputed = TestBit(mRecomputed, index);
+		bool parentChanged = TestBit(mChanged, parent);
+		if (!recomputed && !parentChanged) {
+			continue;
+		}
+
+		if (recomputed) {
+			mLocal[index] = mWorld[index];
+		}
+		mWorld[index] = mLocal[index] * mWorld[parent];
+
+		// moving with the parent counts as moving (so it's interpolated and its owner is told)
+		if (parentChanged) {
+			SetBit(mChanged, index);
+			SetBit(mMoved, index);
+		}
+	}
+
+	// inform owners in one batch, after every matrix is up to date
+	for (size_t word = 0; word < numWords; ++word) {
+		uint64_t changed = mChanged[word];
+		while (changed != 0) {
+			size_t bit = 0;
+			while (((changed >> bit) & 1ull) == 0) {
+				bit += 1;
+			}
+			changed &= changed - 1;  // clear lowest set bit
+			mUpdated.emplace_back(word * 64 + bit);
+		}
+	}
+	for (size_t index : mUpdated) {
+		mOwners[index]->OnWorldTransformUpdated();
+	}
+}
+
+void TransformStore::SaveState() {
+	const size_t bytes = mCount * sizeof(float);
+	if (bytes > 0) {
+		memcpy(mPrevPosX.data(), mPosX.data(), bytes);
+		memcpy(mPrevPosY.data(), mPosY.data(), bytes);
+		memcpy(mPrevPosZ.data(), mPosZ.data(), bytes);
+		memcpy(mPrevRotX.data(), mRotX.data(), bytes);
+		memcpy(mPrevRotY.data(), mRotY.data(), bytes);
+		memcpy(mPrevRotZ.data(), mRotZ.data(), bytes);
+		memcpy(mPrevRotW.data(), mRotW.data(), bytes);
+		memcpy(mPrevScale.data(), mScale.data(), bytes);
+	}
+
+	// nothing has moved since the snapshot yet
+	for (auto& word : mMoved) {
+		word = 0;
+	}
+}
+
+void TransformStore::SaveState(size_t index) {
+	mPrevPosX[index] = mPosX[index];
+	mPrevPosY[index] = mPosY[index];
+	mPrevPosZ[index] = mPosZ[index];
+	mPrevRotX[index] = mRotX[index];
+	mPrevRotY[index] = mRotY[index];
+	mPrevRotZ[index] = mRotZ[index];
+	mPrevRotW[index] = mRotW[index];
+	mPrevScale[index] = mScale[index];
+}
+
+void TransformStore::ComputeRenderTransforms(float alpha) {
+	const size_t numWords = (mCount + 63) / 64;
+	for (size_t word = 0; word < numWords; ++word) {
+		uint64_t moved = mMoved[word];
+		if (moved == 0) {
+			continue;
+		}
+
+		for (size_t group = 0; group < 16; ++group) {
+			if (((moved >> (group * 4)) & 0xF) == 0) {
+				continue;
+			}
+
+			// blend all 4 transforms of the group (for one that didn't move, prev == current)
+			size_t base = word * 64 + group * 4;
+			for (size_t i = base; i < base + 4; ++i) {
+				mRenderPosX[i] = Math::Lerp(mPrevPosX[i], mPosX[i], alpha);
+				mRenderPosY[i] = Math::Lerp(mPrevPosY[i], mPosY[i], alpha);
+				mRenderPosZ[i] = Math::Lerp(mPrevPosZ[i], mPosZ[i], alpha);
+				mRenderScale[i] = Math::Lerp(mPrevScale[i], mScale[i], alpha);
+
+				Quaternion rot = Quaternion::Slerp(
+					Quaternion(mPrevRotX[i], mPrevRotY[i], mPrevRotZ[i], mPrevRotW[i]),
+					Quaternion(mRotX[i], mRotY[i], mRotZ[i], mRotW[i]),
+					alpha);
+				mRenderRotX[i] = rot.x;
+				mRenderRotY[i] = rot.y;
+				mRenderRotZ[i] = rot.z;
+				mRenderRotW[i] = rot.w;
+			}
+
+			ComputeMatrices4(mRenderPosX.data(), mRenderPosY.data(), mRenderPosZ.data(),
+				mRenderRotX.data(), mRenderRotY.data(), mRenderRotZ.data(), mRenderRotW.data(),
+				mRenderScale.data(), base, mRender.data());
+		}
+	}
+
+	// a moved child holds its blended local matrix so far, put it under its parent's blended matrix
+	// (a child that moves with its parent is marked as moved too, so its group was blended above)
+	if (mChildrenDirty) {
+		SortChildren();
+	}
+	for (const auto& child : mChildren) {
+		if (IsMoved(child.mIndex)) {
+			mRender[child.mIndex] = mRender[child.mIndex] * GetRenderTransform(mParents[child.mIndex]);
+		}
+	}
+}
+
+void TransformStore::ComputeMatrices4(const float* posX, const float* posY, const float* posZ,
+	const float* rotX, const float* rotY, const float* rotZ, const float* rotW,
+	const float* scale, size_t index, Matrix4* out) {
+	// each register holds one value for 4 consecutive transforms
+	__m128 x = _mm_loadu_ps(rotX + index);
+	__m128 y = _mm_loadu_ps(rotY + index);
+	__m128 z = _mm_loadu_ps(rotZ + index);
+	__m128 w = _mm_loadu_ps(rotW + index);
+	__m128 s = _mm_loadu_ps(scale + index);
+
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 two = _mm_set1_ps(2.0f);
+
+	// same terms as Matrix4::CreateFromQuaternion
+	__m128 x2 = _mm_mul_ps(two, x);
+	__m128 y2 = _mm_mul_ps(two, y);
+	__m128 z2 = _mm_mul_ps(two, z);
+	__m128 xx = _mm_mul_ps(x2, x);
+	__m128 yy = _mm_mul_ps(y2, y);
+	__m128 zz = _mm_mul_ps(z2, z);
+	__m128 xy = _mm_mul_ps(x2, y);
+	__m128 xz = _mm_mul_ps(x2, z);
+	__m128 yz = _mm_mul_ps(y2, z);
+	__m128 wx = _mm_mul_ps(x2, w);
+	__m128 wy = _mm_mul_ps(y2, w);
+	__m128 wz = _mm_mul_ps(z2, w);
+
+	// rotation rows, multiplied by the uniform scale (scale matrix comes first)
+	__m128 m00 = _mm_mul_ps(s, _mm_sub_ps(_mm_sub_ps(one, yy), zz));
+	__m128 m01 = _mm_mul_ps(s, _mm_add_ps(xy, wz));
+	__m128 m02 = _mm_mul_ps(s, _mm_sub_ps(xz, wy));
+	__m128 m10 = _mm_mul_ps(s, _mm_sub_ps(xy, wz));
+	__m128 m11 = _mm_mul_ps(s, _mm_sub_ps(_mm_sub_ps(one, xx), zz));
+	__m128 m12 = _mm_mul_ps(s, _mm_add_ps(yz, wx));
+	__m128 m20 = _mm_mul_ps(s, _mm_add_ps(xz, wy));
+	__m128 m21 = _mm_mul_ps(s, _mm_sub_ps(yz, wx));
+	__m128 m22 = _mm_mul_ps(s, _mm_sub_ps(_mm_sub_ps(one, xx), yy));
+	__m128 zero = _mm_setzero_ps();
+
+	// translation is the last row
+	__m128 m30 = _mm_loadu_ps(posX + index);
+	__m128 m31 = _mm_loadu_ps(posY + index);
+	__m128 m32 = _mm_loadu_ps(posZ + index);
+	__m128 m33 = one;
+
+	// transpose from "one register per matrix element" to "one register per matrix row"
+	_MM_TRANSPOSE4_PS(m00, m01, m02, zero);
+	__m128 w3 = _mm_setzero_ps();
+	__m128 w4 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(m10, m11, m12, w3);
+	_MM_TRANSPOSE4_PS(m20, m21, m22, w4);
+	_MM_TRANSPOSE4_PS(m30, m31, m32, m33);
+
+	__m128 row0[4] = { m00, m01, m02, zero };
+	__m128 row1[4] = { m10, m11, m12, w3 };
+	__m128 row2[4] = { m20, m21, m22, w4 };
+	__m128 row3[4] = { m30, m31, m32, m33 };
+
+	for (int i = 0; i < 4; ++i) {
+		float* dst = &out[index + i].mat[0][0];
+		_mm_storeu_ps(dst, row0[i]);
+		_mm_storeu_ps(dst + 4, row1[i]);
+		_mm_storeu_ps(dst + 8, row2[i]);
+		_mm_storeu_ps(dst + 12, row3[i]);
+	}
+}
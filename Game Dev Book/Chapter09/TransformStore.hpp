@@ -0,0 +1,217 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include "Math.hpp"
+
+// owns the transforms of every actor in structure-of-arrays form, so world matrices can be rebuilt
+// for all actors in one SIMD pass instead of each actor building three Matrix4s and multiplying them
+// - each actor holds an index into these arrays (indices change when another actor is removed)
+// - setters only write the components and set a bit in the dirty bitset (atomically, so actors can
+//   update in parallel as long as each one only writes its own transform)
+// - ComputeWorldTransforms() rebuilds every dirty world matrix (4 at a time with SSE), then notifies
+//   the owning actors in a batch
+// - a transform can have a parent, its position/rotation/scale are then relative to the parent
+//   (local matrices of children are cached, and children are kept in one list sorted by depth, so a
+//   single pass after the SIMD pass rebuilds only the children that changed or whose parent changed)
+class TransformStore {
+public:
+	// parent index of a root transform
+	static const size_t NoParent = ~static_cast<size_t>(0);
+
+	TransformStore();
+	~TransformStore();
+
+	// allocate a transform for an actor (identity to start with), returns its index
+	size_t Add(class Actor* owner);
+	// release a transform (the last transform is moved into the freed index)
+	void Remove(size_t index);
+
+	size_t GetCount() const {
+		return mCount;
+	}
+
+	// attach a transform to a parent (NoParent detaches it), its position/rotation/scale become relative
+	// to the parent; returns false if that would make a cycle
+	bool SetParent(size_t index, size_t parent);
+	size_t GetParent(size_t index) const {
+		return mParents[index];
+	}
+	class Actor* GetOwner(size_t index) const {
+		return mOwners[index];
+	}
+
+	// getters/setters
+	Vector3 GetPosition(size_t index) const {
+		return Vector3(mPosX[index], mPosY[index], mPosZ[index]);
+	}
+	void SetPosition(size_t index, const Vector3& pos) {
+		mPosX[index] = pos.x;
+		mPosY[index] = pos.y;
+		mPosZ[index] = pos.z;
+		MarkDirty(index);
+	}
+	Quaternion GetRotation(size_t index) const {
+		return Quaternion(mRotX[index], mRotY[index], mRotZ[index], mRotW[index]);
+	}
+	void SetRotation(size_t index, const Quaternion& rot) {
+		mRotX[index] = rot.x;
+		mRotY[index] = rot.y;
+		mRotZ[index] = rot.z;
+		mRotW[index] = rot.w;
+		MarkDirty(index);
+	}
+	float GetScale(size_t index) const {
+		return mScale[index];
+	}
+	void SetScale(size_t index, float scale) {
+		mScale[index] = scale;
+		MarkDirty(index);
+	}
+
+	const Matrix4& GetWorldTransform(size_t index) const {
+		return mWorld[index];
+	}
+
+	bool IsDirty(size_t index) const {
+		return (mDirty[index / 64].load(std::memory_order_relaxed) & (1ull << (index % 64))) != 0;
+	}
+	void MarkDirty(size_t index) {
+		mDirty[index / 64].fetch_or(1ull << (index % 64), std::memory_order_relaxed);
+	}
+
+	// rebuild the world matrix of every dirty transform, then tell the owners (in one batch afterwards)
+	void ComputeWorldTransforms();
+
+	// render interpolation
+	// snapshot the current transforms as the "previous" simulation state
+	void SaveState();
+	// blend the transforms that moved since the snapshot (alpha in [0, 1])
+	void ComputeRenderTransforms(float alpha);
+
+	const Matrix4& GetRenderTransform(size_t index) const {
+		return IsMoved(index) ? mRender[index] : mWorld[index];
+	}
+	Vector3 GetRenderPosition(size_t index) const {
+		// children: the world position, from the matrix
+		if (mParents[index] != NoParent) {
+			return GetRenderTransform(index).GetTranslation();
+		}
+		if (IsMoved(index)) {
+			return Vector3(mRenderPosX[index], mRenderPosY[index], mRenderPosZ[index]);
+		}
+		return GetPosition(index);
+	}
+	Quaternion GetRenderRotation(size_t index) const {
+		Quaternion rot = IsMoved(index) ?
+			Quaternion(mRenderRotX[index], mRenderRotY[index], mRenderRotZ[index], mRenderRotW[index]) :
+			GetRotation(index);
+		// children: the world rotation, their own rotation followed by the parent's
+		if (mParents[index] != NoParent) {
+			rot = Quaternion::Concatenate(rot, GetRenderRotation(mParents[index]));
+		}
+		return rot;
+	}
+
+private:
+	bool IsMoved(size_t index) const {
+		return (mMoved[index / 64] & (1ull << (index % 64))) != 0;
+	}
+
+	// snapshot a single transform as its own previous state
+	void SaveState(size_t index);
+
+	// rotation/scale in world space, from the current (not yet rebuilt) state of the transform and its parents
+	Quaternion ComputeWorldRotation(size_t index) const;
+	float ComputeWorldScale(size_t index) const;
+
+	// recompute the depth of every child and re-sort mChildren (after parents changed)
+	void SortChildren();
+	// number of ancestors
+	uint32_t ComputeDepth(size_t index) const;
+	static bool TestBit(const std::vector<uint64_t>& bits, size_t index) {
+		return (bits[index / 64] & (1ull << (index % 64))) != 0;
+	}
+	static void SetBit(std::vector<uint64_t>& bits, size_t index) {
+		bits[index / 64] |= 1ull << (index % 64);
+	}
+
+	// grow every array so at least "count" transforms fit (capacity is kept a multiple of 64)
+	void Reserve(size_t count);
+
+	// build scale * rotation * translation matrices for transforms [index, index + 4) from the given arrays
+	static void ComputeMatrices4(const float* posX, const float* posY, const float* posZ,
+		const float* rotX, const float* rotY, const float* rotZ, const float* rotW,
+		const float* scale, size_t index, Matrix4* out);
+
+private:
+	// number of live transforms
+	size_t mCount;
+	// allocated size of every array (entries past mCount are identity padding)
+	size_t mCapacity;
+
+	// current simulation state
+	std::vector<float> mPosX;
+	std::vector<float> mPosY;
+	std::vector<float> mPosZ;
+	std::vector<float> mRotX;
+	std::vector<float> mRotY;
+	std::vector<float> mRotZ;
+	std::vector<float> mRotW;
+	std::vector<float> mScale;
+	std::vector<Matrix4> mWorld;
+
+	// hierarchy
+	// parent of every transform (NoParent for roots)
+	std::vector<size_t> mParents;
+	// cached local matrix (only kept up to date for children, roots' world matrix is their local matrix)
+	std::vector<Matrix4> mLocal;
+	struct Child {
+		size_t mIndex;
+		uint32_t mDepth;
+	};
+	// every transform with a parent, parents before their children
+	std::vector<Child> mChildren;
+	// depths/order of mChildren are stale
+	bool mChildrenDirty;
+
+	// state at the start of the current simulation step
+	std::vector<float> mPrevPosX;
+	std::vector<float> mPrevPosY;
+	std::vector<float> mPrevPosZ;
+	std::vector<float> mPrevRotX;
+	std::vector<float> mPrevRotY;
+	std::vector<float> mPrevRotZ;
+	std::vector<float> mPrevRotW;
+	std::vector<float> mPrevScale;
+
+	// blended state for drawing (only valid for transforms that moved)
+	std::vector<float> mRenderPosX;
+	std::vector<float> mRenderPosY;
+	std::vector<float> mRenderPosZ;
+	std::vector<float> mRenderRotX;
+	std::vector<float> mRenderRotY;
+	std::vector<float> mRenderRotZ;
+	std::vector<float> mRenderRotW;
+	std::vector<float> mRenderScale;
+	std::vector<Matrix4> mRender;
+
+	// one bit per transform: needs its world matrix rebuilt
+	// (atomics can't live in a std::vector, so this is grown by hand in Reserve)
+	std::unique_ptr<std::atomic<uint64_t>[]> mDirty;
+	// one bit per transform: changed since the last SaveState (so it has to be interpolated)
+	std::vector<uint64_t> mMoved;
+	// one bit per transform: added since the last ComputeWorldTransforms (no previous state to blend from)
+	std::vector<uint64_t> mAdded;
+	// scratch bits for ComputeWorldTransforms: world matrix changed / matrix slot rewritten by the SIMD pass
+	std::vector<uint64_t> mChanged;
+	std::vector<uint64_t> mRecomputed;
+
+	// actor owning each transform
+	std::vector<class Actor*> mOwners;
+	// scratch list of transforms updated this pass (kept around to avoid reallocating every frame)
+	std::vector<size_t> mUpdated;
+};
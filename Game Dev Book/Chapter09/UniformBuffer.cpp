@@ -0,0 +1,30 @@
+#include "UniformBuffer.hpp"
+#include "Counters.hpp"
+
+UniformBuffer::UniformBuffer(unsigned int size, unsigned int binding) {
+	mSize = size;
+	mBinding = binding;
+	mTag = MemoryTracker::GetCurrentTag();
+	MemoryTracker::AddExternal(mTag, mSize);
+
+	// create the buffer with room for the data, it's filled in by Update
+	glGenBuffers(1, &mBuffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, mBuffer);
+	glBufferData(GL_UNIFORM_BUFFER, mSize, nullptr, GL_DYNAMIC_DRAW);
+
+	// attach the buffer to its binding point (it stays there, shader programs only refer to the binding point)
+	glBindBufferBase(GL_UNIFORM_BUFFER, mBinding, mBuffer);
+}
+
+UniformBuffer::~UniformBuffer() {
+	glDeleteBuffers(1, &mBuffer);
+	MemoryTracker::RemoveExternal(mTag, mSize);
+}
+
+void UniformBuffer::Update(const void* data) {
+	glBindBuffer(GL_UNIFORM_BUFFER, mBuffer);
+	// the whole buffer is replaced, so let the driver hand us fresh storage instead of waiting on the GPU
+	glBufferData(GL_UNIFORM_BUFFER, mSize, nullptr, GL_DYNAMIC_DRAW);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, mSize, data);
+	COUNTER_ADD("UniformBufferUploads", 1);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "GL/glew.h"
+#include "MemoryTracker.hpp"
+
+// class representing a uniform buffer object, a block of uniform data that lives on the GPU
+// and is shared by every shader program whose uniform block is bound to the same binding point
+// (the layout of the data has to match the block's std140 layout in the shaders)
+class UniformBuffer {
+public:
+	UniformBuffer(unsigned int size, unsigned int binding);
+	~UniformBuffer();
+
+	// replace the whole buffer with data (size bytes, as given on creation)
+	void Update(const void* data);
+
+	unsigned int GetBinding() const {
+		return mBinding;
+	}
+
+private:
+	// OpenGL ID of the buffer
+	unsigned int mBuffer;
+	// size of the buffer in bytes
+	unsigned int mSize;
+	// uniform block binding point the buffer is attached to
+	unsigned int mBinding;
+	// GPU memory of the buffer, reported to the MemoryTracker under the tag current when it was created
+	MemoryTracker::Tag mTag;
+};
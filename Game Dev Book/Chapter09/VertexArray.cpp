@@ -1,9 +1,14 @@
 #include "VertexArray.hpp"
+#include "Counters.hpp"
 
 VertexArray::VertexArray(const float* verts, unsigned int numVerts,
 	const unsigned int* indices, unsigned int numIndices) {
 	mNumVerts = numVerts;
 	mNumIndices = numIndices;
+	// meshes create theirs under EMesh, the renderer's own (sprite quad) are ERenderer
+	mTag = MemoryTracker::GetCurrentTag();
+	mBytes = static_cast<int64_t>(numVerts) * 8 * sizeof(float) + static_cast<int64_t>(numIndices) * sizeof(unsigned int);
+	MemoryTracker::AddExternal(mTag, mBytes);
 
 	// create the vertex array object and store its ID in the mVertexArray variable
 	glGenVertexArrays(1, &mVertexArray);
@@ -74,8 +79,28 @@ VertexArray::~VertexArray() {
 	glDeleteBuffers(1, &mVertexBuffer);
 	glDeleteBuffers(1, &mIndexBuffer);
 	glDeleteVertexArrays(1, &mVertexArray);
+	MemoryTracker::RemoveExternal(mTag, mBytes);
+}
+
+void VertexArray::SetInstanceBuffer(unsigned int buffer, size_t offset) {
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	// a mat4 attribute takes 4 slots, one per row of the matrix (GLSL sees the rows as its columns)
+	for (unsigned int row = 0; row < 4; ++row) {
+		glEnableVertexAttribArray(3 + row);
+		glVertexAttribPointer(
+			3 + row,
+			4,  // 4 floats per row
+			GL_FLOAT,
+			GL_FALSE,
+			sizeof(float) * 16,  // stride - one matrix per instance
+			reinterpret_cast<void*>(offset + sizeof(float) * 4 * row)
+		);
+		// advance once per instance instead of once per vertex
+		glVertexAttribDivisor(3 + row, 1);
+	}
 }
 
 void VertexArray::SetActive() {
 	glBindVertexArray(mVertexArray);
+	COUNTER_ADD("VertexArrayBinds", 1);
 }
\ No newline at end of file
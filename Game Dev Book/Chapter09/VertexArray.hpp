@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include "GL/glew.h"
+#include "MemoryTracker.hpp"
 
 // class representing a vertex array object, which encapsulates a vertex buffer, an index
 // buffer, and the vertex layout which specifies what data you store for each vertex in the model
@@ -12,6 +14,9 @@ public:
 
 	// activate this vertex array (so we can draw it)
 	void SetActive();
+	// read per-instance world transforms (attributes 3-6, one Matrix4 per instance) from buffer,
+	// starting offset bytes in (the vertex array must be active)
+	void SetInstanceBuffer(unsigned int buffer, size_t offset);
 
 	unsigned int GetNumIndices() const {
 		return mNumIndices;
@@ -21,6 +26,11 @@ public:
 		return mNumVerts;
 	}
 
+	// OpenGL ID of the vertex array object
+	unsigned int GetArrayID() const {
+		return mVertexArray;
+	}
+
 private:
 	// how many vertices in the vertex buffer?
 	unsigned int mNumVerts;
@@ -32,4 +42,7 @@ private:
 	unsigned int mIndexBuffer;
 	// OpenGL ID of the vertex array object
 	unsigned int mVertexArray;
+	// GPU memory of the buffers, reported to the MemoryTracker under the tag current when it was created
+	MemoryTracker::Tag mTag;
+	int64_t mBytes;
 };
\ No newline at end of file
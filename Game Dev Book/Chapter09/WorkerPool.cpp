@@ -0,0 +1,110 @@
+#include "WorkerPool.hpp"
+
+thread_local size_t WorkerPool::sThreadIndex = 0;
+
+WorkerPool::WorkerPool(size_t numWorkers) {
+	mFunc = nullptr;
+	mCount = 0;
+	mBatchSize = 1;
+	mNextIndex = 0;
+	mBusyWorkers = 0;
+	mJobId = 0;
+	mShutdown = false;
+
+	if (numWorkers == 0) {
+		// the calling thread works too, so leave one hardware thread for it
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		numWorkers = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	for (size_t i = 0; i < numWorkers; ++i) {
+		mWorkers.emplace_back(&WorkerPool::WorkerLoop, this, i + 1);
+	}
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mShutdown = true;
+	}
+	mWorkReady.notify_all();
+
+	for (auto& worker : mWorkers) {
+		worker.join();
+	}
+}
+
+void WorkerPool::ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)>& func) {
+	if (count == 0) {
+		return;
+	}
+	if (batchSize == 0) {
+		batchSize = 1;
+	}
+
+	// not worth waking anyone up for a single batch
+	if (mWorkers.empty() || count <= batchSize) {
+		func(0, count);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mFunc = &func;
+		mCount = count;
+		mBatchSize = batchSize;
+		mNextIndex = 0;
+		mBusyWorkers = mWorkers.size();
+		mJobId += 1;
+	}
+	mWorkReady.notify_all();
+
+	// help out instead of just waiting
+	RunBatches();
+
+	// wait for the workers to finish their last batches
+	std::unique_lock<std::mutex> lock(mMutex);
+	mWorkDone.wait(lock, [this] { return mBusyWorkers == 0; });
+	mFunc = nullptr;
+}
+
+void WorkerPool::WorkerLoop(size_t threadIndex) {
+	sThreadIndex = threadIndex;
+	uint64_t lastJobId = 0;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mWorkReady.wait(lock, [this, lastJobId] { return mShutdown || mJobId != lastJobId; });
+			if (mShutdown) {
+				return;
+			}
+			lastJobId = mJobId;
+		}
+
+		RunBatches();
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mBusyWorkers -= 1;
+			if (mBusyWorkers == 0) {
+				mWorkDone.notify_one();
+			}
+		}
+	}
+}
+
+void WorkerPool::RunBatches() {
+	while (true) {
+		size_t begin = mNextIndex.fetch_add(mBatchSize);
+		if (begin >= mCount) {
+			return;
+		}
+
+		size_t end = begin + mBatchSize;
+		if (end > mCount) {
+			end = mCount;
+		}
+		(*mFunc)(begin, end);
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+// fixed set of worker threads for splitting a loop across cores
+// - ParallelFor hands out batches of indices to the workers and the calling thread, and returns once
+//   every batch is done (so the caller is the sync point)
+// - every thread has an index (0 for the thread that created the pool, 1..N for the workers), which
+//   can be used to pick per-thread data such as command buffers
+// NOTE: ParallelFor must only be called from the thread that created the pool (no nesting)
+class WorkerPool {
+public:
+	// numWorkers = 0 picks one worker per extra hardware thread
+	WorkerPool(size_t numWorkers = 0);
+	~WorkerPool();
+
+	// workers plus the calling thread
+	size_t GetNumThreads() const {
+		return mWorkers.size() + 1;
+	}
+
+	// call func(begin, end) for batches covering [0, count), spread across all threads
+	void ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)>& func);
+
+	// index of the calling thread
+	static size_t GetThreadIndex() {
+		return sThreadIndex;
+	}
+
+private:
+	void WorkerLoop(size_t threadIndex);
+	// grab batches of the current job until there are none left
+	void RunBatches();
+
+	std::vector<std::thread> mWorkers;
+
+	std::mutex mMutex;
+	// signalled when a new job is posted (or on shutdown)
+	std::condition_variable mWorkReady;
+	// signalled when the last worker finishes the current job
+	std::condition_variable mWorkDone;
+
+	// current job
+	const std::function<void(size_t, size_t)>* mFunc;
+	size_t mCount;
+	size_t mBatchSize;
+	std::atomic<size_t> mNextIndex;
+	// workers that haven't finished the current job yet
+	size_t mBusyWorkers;
+	// bumped for every job, so workers can tell a new job from a spurious wakeup
+	uint64_t mJobId;
+	bool mShutdown;
+
+	static thread_local size_t sThreadIndex;
+};
@@ -5,6 +5,7 @@
 #include "Ship.hpp"
 #include "Asteroid.hpp"
 #include "Random.hpp"
+#include "TimerWheel.hpp"
 #include <algorithm>
 
 Game::Game() {
@@ -13,6 +14,7 @@ Game::Game() {
     mRenderer = nullptr;
     mUpdatingActors = false;
     mTicksCount = 0;
+    mTimers = new TimerWheel();
 }
 
 bool Game::Initialize() {
@@ -70,6 +72,9 @@ void Game::RunLoop() {
 
 void Game::ShutDown() {
     UnloadData();
+    // actors cancel their own timers, so this goes after them
+    delete mTimers;
+    mTimers = nullptr;
     IMG_Quit();
     SDL_DestroyWindow(mWindow);
     SDL_DestroyRenderer(mRenderer);
@@ -232,6 +237,9 @@ void Game::UpdateGame() {
 
     mTicksCount = SDL_GetTicks();
 
+    // fire any timers that came due (lifetimes, cooldowns)
+    mTimers->Advance(deltaTime);
+
     // update all actors
     mUpdatingActors = true;
     for (auto actor : mActors) {
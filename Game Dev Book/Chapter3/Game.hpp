@@ -27,6 +27,11 @@ public:
     void AddAsteroid(class Asteroid* asteroid);
     void RemoveAsteroid(class Asteroid* asteroid);
 
+    // gameplay timers (advanced once per frame, before actors update)
+    class TimerWheel* GetTimers() {
+        return mTimers;
+    }
+
 private:
     void ProcessInput();
     void UpdateGame();
@@ -49,6 +54,8 @@ private:
     // track if we are updating actors right now
     bool mUpdatingActors;
 
+    class TimerWheel* mTimers;
+
     // game-specific
     class Ship* mShip;  // Player's ship
     std::vector<class Asteroid*> mAsteroids;
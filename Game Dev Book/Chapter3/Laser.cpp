@@ -4,6 +4,7 @@
 #include "MoveComponent.hpp"
 #include "CircleComponent.hpp"
 #include "Asteroid.hpp"
+#include "TimerWheel.hpp"
 
 Laser::Laser(Game* game, float rotation) : Actor(game) {
 	// create a sprite component
@@ -23,18 +24,17 @@ Laser::Laser(Game* game, float rotation) : Actor(game) {
 	mc->SetMass(0.01f);  // Exercise 3.3
 	mc->AddForce(Vector2(Math::Cos(GetRotation()), -Math::Sin(GetRotation())) * 250.0f);  // Exercise 3.3
 
-	mAliveTime = 1.0f;
-}
-
-void Laser::UpdateActor(float deltaTime) {
 	// if we run out of time, laser is dead
-	mAliveTime -= deltaTime;
-	if (mAliveTime <= 0.0f) {
-		// remove this laser
+	mAliveTimer = game->GetTimers()->Schedule(1.0f, [this]() {
 		SetState(EDead);
-		return;
-	}
+	});
+}
+
+Laser::~Laser() {
+	GetGame()->GetTimers()->Cancel(mAliveTimer);
+}
 
+void Laser::UpdateActor(float /*deltaTime*/) {
 	// test for intersection against asteroids
 	// do we intersect with an asteroid?
 	for (auto ast : GetGame()->GetAsteroids()) {
@@ -1,15 +1,18 @@
 #pragma once
 
 #include "Actor.hpp"
+#include "TimerWheel.hpp"
 
 class Laser : public Actor
 {
 public:
 	Laser(class Game* game, float rotation);
+	~Laser();
 
 	void UpdateActor(float deltaTime) override;
 
 private:
 	class CircleComponent* mCircle;
-	float mAliveTime;
+	// kills the laser when it runs out
+	TimerHandle mAliveTimer;
 };
\ No newline at end of file
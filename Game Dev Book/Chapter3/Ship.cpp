@@ -5,6 +5,7 @@
 #include "CircleComponent.hpp"
 #include "Asteroid.hpp"
 #include "Laser.hpp"
+#include "TimerWheel.hpp"
 
 Ship::Ship(Game* game) : Actor(game) {
 	// create a sprite component
@@ -28,33 +29,35 @@ Ship::Ship(Game* game) : Actor(game) {
 	mCircleComp = new CircleComponent(this);
 	mCircleComp->SetRadius(40.0f);
 
-	mLaserCooldown = 0.0f;
-	mResetTimer = 2.0f;
+	mCanFire = true;
 	mDead = false;
 }
 
+Ship::~Ship() {
+	GetGame()->GetTimers()->Cancel(mLaserCooldown);
+	GetGame()->GetTimers()->Cancel(mResetTimer);
+}
+
 void Ship::ActorInput(const uint8_t* keyState) {
-	if (keyState[SDL_SCANCODE_SPACE] && mLaserCooldown <= 0.0f && !mDead) {
+	if (keyState[SDL_SCANCODE_SPACE] && mCanFire && !mDead) {
 		// create a laser and set its position/rotation to mine
 		Laser* laser = new Laser(GetGame(), GetRotation());
 		laser->SetPosition(GetPosition());
 
-		// reset laser cooldown (half second)
-		mLaserCooldown = 0.5f;
+		// laser cooldown (half second)
+		mCanFire = false;
+		mLaserCooldown = GetGame()->GetTimers()->Schedule(0.5f, [this]() {
+			mCanFire = true;
+		});
 	}
 }
 
-void Ship::UpdateActor(float deltaTime) {
-	if (mResetTimer <= 0.0f) {
-		OnRevive();
-	}
-	else if (mDead) {
-		mResetTimer -= deltaTime;
+void Ship::UpdateActor(float /*deltaTime*/) {
+	// waiting on the reset timer to revive
+	if (mDead) {
 		return;
 	}
 
-	mLaserCooldown -= deltaTime;
-
 	// check if ship has a forward speed
 	//if (!Math::NearZero(mInputComp->GetForwardSpeed())) {
 	//	// change texture if so
@@ -86,12 +89,16 @@ void Ship::UpdateActor(float deltaTime) {
 void Ship::OnDeath() {
 	mDead = true;
 	mSpriteComp->SetTexture(nullptr);
+	// revive after two seconds
+	mResetTimer = GetGame()->GetTimers()->Schedule(2.0f, [this]() {
+		OnRevive();
+	});
 }
 
 // Exercise 3.2
 void Ship::OnRevive() {
-	mResetTimer = 2.0f;
-	mLaserCooldown = 0.0f;
+	GetGame()->GetTimers()->Cancel(mLaserCooldown);
+	mCanFire = true;
 	SetPosition(Vector2(512.0f, 384.0f));
 	SetRotation(Math::PiOver2);
 	mInputComp->SetVelocity(Vector2::Zero);
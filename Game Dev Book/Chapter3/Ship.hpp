@@ -1,10 +1,12 @@
 #pragma once
 
 #include "Actor.hpp"
+#include "TimerWheel.hpp"
 
 class Ship : public Actor {
 public:
 	Ship(class Game* game);
+	~Ship();
 
 	void ActorInput(const uint8_t* keyState) override;
 	void UpdateActor(float deltaTime) override;
@@ -13,8 +15,11 @@ public:
 	void OnRevive();
 
 private:
-	float mLaserCooldown;
-	float mResetTimer;
+	// cleared while the laser cooldown timer runs
+	bool mCanFire;
+	TimerHandle mLaserCooldown;
+	// revives the ship after it died
+	TimerHandle mResetTimer;
 	bool mDead;
 
 	class InputComponent* mInputComp;
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+// refers to a scheduled timer (stays safe to use after the timer fired or was cancelled)
+struct TimerHandle {
+	uint32_t mIndex;
+	// 0 is never a live timer, so a default handle refers to nothing
+	uint32_t mGeneration;
+
+	TimerHandle() : mIndex(0), mGeneration(0) {}
+	TimerHandle(uint32_t index, uint32_t generation) : mIndex(index), mGeneration(generation) {}
+};
+
+// gameplay timers (lifetimes, cooldowns, spawn intervals) on a hierarchical timing wheel
+// - time is counted in ticks of TickLength seconds
+// - level 0 has one slot per tick for the next SlotsPerLevel ticks, each higher level has slots
+//   SlotsPerLevel times as wide; a timer sits in the level matching how far away it is, and moves
+//   down a level when the wheel reaches the start of its slot
+// - scheduling and cancelling are O(1) (a timer is a node in a doubly linked slot list),
+//   and Advance only touches the slots that come due, so waiting timers cost nothing per frame
+// - callbacks run from Advance, on expiry only
+class TimerWheel {
+public:
+	TimerWheel();
+
+	// call callback after delay seconds (and then every interval seconds, if interval > 0)
+	TimerHandle Schedule(float delay, const std::function<void()>& callback, float interval = 0.0f);
+	// returns false if the timer already fired (one-shot) or was cancelled
+	bool Cancel(TimerHandle handle);
+	bool IsActive(TimerHandle handle) const;
+
+	// move time forward, firing every timer that comes due (in expiry order)
+	void Advance(float deltaTime);
+
+	size_t GetNumActive() const {
+		return mNumActive;
+	}
+
+	// seconds per tick
+	static const float TickLength;
+
+private:
+	static const uint32_t Invalid = ~0u;
+	static const uint32_t SlotBits = 6;
+	static const uint32_t SlotsPerLevel = 1 << SlotBits;
+	static const uint32_t NumLevels = 4;
+
+	struct Timer {
+		std::function<void()> mCallback;
+		uint64_t mExpiry;  // tick the timer fires on
+		uint64_t mInterval;  // ticks between repeats (0 for one-shot)
+		uint32_t mPrev;
+		uint32_t mNext;
+		uint32_t mGeneration;
+		uint32_t mSlot;  // level * SlotsPerLevel + slot, or Invalid when not scheduled
+	};
+
+	// move the wheel forward one tick
+	void Tick();
+	// put a timer in the slot matching its expiry
+	void Insert(uint32_t index);
+	// take a timer out of its slot list
+	void Unlink(uint32_t index);
+	// return a timer to the free list
+	void Release(uint32_t index);
+
+	std::vector<Timer> mTimers;
+	std::vector<uint32_t> mFreeTimers;
+	// head of each slot list, for every level
+	uint32_t mSlots[NumLevels * SlotsPerLevel];
+	// one bit per slot with a timer in it, per level
+	uint64_t mOccupied[NumLevels];
+
+	uint64_t mCurrentTick;
+	// seconds of Advance not covered by a whole tick yet
+	float mRemainder;
+	size_t mNumActive;
+};
@@ -2,16 +2,24 @@
 #include "Actor.hpp"
 #include "AIState.hpp"
 #include "SDL_log.h"
+#include "MemoryTracker.hpp"
 
 AIComponent::AIComponent(Actor* owner) : Component(owner) {
 	mCurrentState = nullptr;
 }
 
+AIComponent::~AIComponent() {
+	for (auto& iter : mStateMap) {
+		delete iter.second;
+	}
+}
+
 void AIComponent::RegisterState(AIState* state) {
 	mStateMap.emplace(state->GetName(), state);
 }
 
 void AIComponent::Update(float deltaTime) {
+	MEMORY_TAG_SCOPE(EAI);
 	// calls Update() on the current state
 	if (mCurrentState) {
 		mCurrentState->Update(deltaTime);
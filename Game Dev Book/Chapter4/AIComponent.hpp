@@ -8,6 +8,8 @@
 class AIComponent : public Component {
 public:
 	AIComponent(class Actor* owner);
+	// deletes the registered states
+	~AIComponent();
 
 	void Update(float deltaTime) override;
 	void ChangeState(const std::string& name);
@@ -4,6 +4,7 @@
 class AIState {
 public:
 	AIState(class AIComponent* owner) : mOwner(owner) {}
+	virtual ~AIState() {}
 
 	// state-specific behaviour
 	virtual void Update(float deltaTime) = 0;  // updates the state per frame
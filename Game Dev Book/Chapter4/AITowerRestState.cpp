@@ -1,24 +1,27 @@
 #include "AITowerRestState.hpp"
 #include "AIComponent.hpp"
+#include "Actor.hpp"
+#include "Game.hpp"
 
 AITowerRestState::AITowerRestState(AIComponent* owner) : AIState(owner) {
-	mNextAttack = AttackTime;
+
 }
 
-void AITowerRestState::Update(float deltaTime) {
-	mNextAttack -= deltaTime;
-	// check if attack cooldown has finished
-	if (mNextAttack <= 0.0f) {
-		// transition to AITowerFireState
-		mOwner->ChangeState("Fire");
-		mNextAttack += AttackTime;
-	}
+AITowerRestState::~AITowerRestState() {
+	OnExit();
 }
 
-void AITowerRestState::OnEnter() {
+void AITowerRestState::Update(float /*deltaTime*/) {
+	// nothing to do until the attack timer fires
+}
 
+void AITowerRestState::OnEnter() {
+	// when the attack cooldown has finished, transition to AITowerFireState
+	mAttackTimer = mOwner->GetOwningActor()->GetGame()->GetTimers()->Schedule(AttackTime, [this]() {
+		mOwner->ChangeState("Fire");
+	});
 }
 
 void AITowerRestState::OnExit() {
-
+	mOwner->GetOwningActor()->GetGame()->GetTimers()->Cancel(mAttackTimer);
 }
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "AIState.hpp"
+#include "TimerWheel.hpp"
 
 class AITowerRestState : public AIState {
 public:
 	AITowerRestState(class AIComponent* owner);
+	~AITowerRestState();
 
 	void Update(float deltaTime) override;
 	void OnEnter() override;
@@ -15,6 +17,6 @@ public:
 	}
 
 private:
-	float mNextAttack;  // tower attack timer
+	TimerHandle mAttackTimer;  // switches to the fire state when the tower has rested long enough
 	const float AttackTime = 2.5f;
 };
\ No newline at end of file
@@ -35,8 +35,10 @@ void Actor::Update(float deltaTime) {
 }
 
 void Actor::UpdateComponents(float deltaTime) {
+	// each component decides from its update rate whether it runs this frame
+	uint32_t frame = mGame->GetFrameNumber();
 	for (int i = 0; i < mComponents.size(); ++i) {
-		mComponents[i]->Update(deltaTime);
+		mComponents[i]->Tick(frame, deltaTime);
 	}
 }
 
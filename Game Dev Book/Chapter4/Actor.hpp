@@ -3,8 +3,12 @@
 #include <vector>
 #include "Math.hpp"
 #include <cstdint>
+#include "PoolAllocator.hpp"
 
 class Actor {
+	// actors/components of every type come from the size-class pools
+	DECLARE_POOL_ALLOCATED()
+
 public:
 	// used to track state of actor
 	enum State {
@@ -19,7 +23,7 @@ public:
 
 	// update function called from Game (not overridable)
 	void Update(float deltaTime);
-	// updates all the components attached to the actor (not overridable)
+	// updates all the components attached to the actor that are due this frame (not overridable)
 	void UpdateComponents(float deltaTime);
 	// any actor-specific update code (overridable)
 	virtual void UpdateActor(float deltaTime);
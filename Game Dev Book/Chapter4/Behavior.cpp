@@ -0,0 +1,143 @@
+#include "Behavior.hpp"
+#include <algorithm>
+#include "MemoryTracker.hpp"
+
+Behavior::Behavior(Behavior&& other) noexcept {
+	mHandle = other.mHandle;
+	other.mHandle = nullptr;
+}
+
+Behavior& Behavior::operator=(Behavior&& other) noexcept {
+	if (this != &other) {
+		Destroy();
+		mHandle = other.mHandle;
+		other.mHandle = nullptr;
+	}
+	return *this;
+}
+
+Behavior::~Behavior() {
+	Destroy();
+}
+
+void Behavior::Destroy() {
+	if (!mHandle) {
+		return;
+	}
+
+	if (mHandle.promise().mScheduler) {
+		mHandle.promise().mScheduler->Cancel(mHandle);
+	}
+	mHandle.destroy();
+	mHandle = nullptr;
+}
+
+void Seconds::await_suspend(Behavior::Handle handle) {
+	handle.promise().mScheduler->WaitFor(handle, mSeconds);
+}
+
+void Until::await_suspend(Behavior::Handle handle) {
+	handle.promise().mScheduler->WaitUntil(handle, std::move(mCondition), mEveryFrame);
+}
+
+BehaviorScheduler::BehaviorScheduler(TimerWheel* timers) {
+	mTimers = timers;
+	mNextBucket = 0;
+	mFrame = 0;
+}
+
+void BehaviorScheduler::Start(Behavior::Handle handle) {
+	handle.promise().mScheduler = this;
+	MakeReady(handle);
+}
+
+void BehaviorScheduler::WaitFor(Behavior::Handle handle, float seconds) {
+	handle.promise().mWait = Behavior::ETimer;
+	handle.promise().mTimer = mTimers->Schedule(seconds, [this, handle]() {
+		MakeReady(handle);
+	});
+}
+
+void BehaviorScheduler::WaitUntil(Behavior::Handle handle, std::function<bool()> condition, bool everyFrame) {
+	uint32_t bucket = EveryFrameBucket;
+	if (!everyFrame) {
+		bucket = mNextBucket;
+		mNextBucket = (mNextBucket + 1) % NumConditionBuckets;
+	}
+
+	handle.promise().mWait = Behavior::ECondition;
+	handle.promise().mBucket = bucket;
+	mConditions[bucket].emplace_back(Condition{ handle, std::move(condition) });
+}
+
+void BehaviorScheduler::Cancel(Behavior::Handle handle) {
+	Behavior::promise_type& promise = handle.promise();
+	switch (promise.mWait) {
+	case Behavior::EReady: {
+		auto iter = std::find(mReady.begin(), mReady.end(), handle);
+		if (iter != mReady.end()) {
+			mReady.erase(iter);
+		}
+		// or it's about to be resumed by Update, skip it there
+		std::replace(mResuming.begin(), mResuming.end(), handle, Behavior::Handle());
+		break;
+	}
+	case Behavior::ETimer:
+		mTimers->Cancel(promise.mTimer);
+		break;
+	case Behavior::ECondition: {
+		std::vector<Condition>& conditions = mConditions[promise.mBucket];
+		for (size_t i = 0; i < conditions.size(); ++i) {
+			if (conditions[i].mHandle == handle) {
+				conditions[i] = std::move(conditions.back());
+				conditions.pop_back();
+				break;
+			}
+		}
+		break;
+	}
+	default:
+		break;
+	}
+	promise.mWait = Behavior::ENone;
+}
+
+void BehaviorScheduler::Update() {
+	// whatever the behaviours allocate while they run is AI memory
+	MEMORY_TAG_SCOPE(EAI);
+
+	// check one bucket of conditions per frame, and the every-frame ones
+	CheckConditions(mConditions[mFrame % NumConditionBuckets]);
+	CheckConditions(mConditions[EveryFrameBucket]);
+	mFrame += 1;
+
+	// resume everything that is ready
+	mResuming.swap(mReady);
+	for (size_t i = 0; i < mResuming.size(); ++i) {
+		Behavior::Handle handle = mResuming[i];
+		if (!handle) {
+			continue;
+		}
+		handle.promise().mWait = Behavior::ENone;
+		handle.resume();
+	}
+	mResuming.clear();
+}
+
+void BehaviorScheduler::CheckConditions(std::vector<Condition>& conditions) {
+	for (size_t i = 0; i < conditions.size(); ) {
+		if (conditions[i].mCondition()) {
+			MakeReady(conditions[i].mHandle);
+			conditions[i] = std::move(conditions.back());
+			conditions.pop_back();
+		}
+		else {
+			++i;
+		}
+	}
+}
+
+void BehaviorScheduler::MakeReady(Behavior::Handle handle) {
+	handle.promise().mWait = Behavior::EReady;
+	mReady.emplace_back(handle);
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <coroutine>
+#include <functional>
+#include <vector>
+#include <cstdint>
+#include <exception>
+#include "PoolAllocator.hpp"
+#include "TimerWheel.hpp"
+
+// coroutine actor behaviours, e.g.
+//     Behavior Tower::Attack() {
+//         while (true) {
+//             co_await Until(...);  // sleep until an enemy is in range
+//             ...fire...
+//             co_await Seconds(2.0f);  // cooldown
+//         }
+//     }
+// a suspended behaviour costs nothing per frame: BehaviorScheduler only resumes it when its timer
+// fires or its condition holds
+// - frames come from the PoolAllocator, so spawning/killing agents doesn't hit the heap
+// - a Behavior owns its coroutine frame (destroying it cancels whatever it was waiting on)
+class Behavior {
+public:
+	// what a suspended behaviour is waiting for (so it can be cancelled)
+	enum Wait {
+		ENone,
+		EReady,  // queued to resume on the next BehaviorScheduler::Update
+		ETimer,
+		ECondition
+	};
+
+	struct promise_type {
+		Behavior get_return_object() {
+			return Behavior(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+		// doesn't run until BehaviorComponent::Run hands it to the scheduler
+		std::suspend_always initial_suspend() noexcept {
+			return {};
+		}
+		// stays around until the owning Behavior destroys it
+		std::suspend_always final_suspend() noexcept {
+			return {};
+		}
+		void return_void() {}
+		void unhandled_exception() {
+			std::terminate();
+		}
+
+		static void* operator new(size_t size) {
+			return PoolAllocator::Allocate(size);
+		}
+		static void operator delete(void* ptr, size_t size) {
+			PoolAllocator::Free(ptr, size);
+		}
+
+		class BehaviorScheduler* mScheduler = nullptr;
+		Wait mWait = ENone;
+		TimerHandle mTimer;
+		uint32_t mBucket = 0;  // condition bucket while waiting on ECondition
+	};
+	using Handle = std::coroutine_handle<promise_type>;
+
+	Behavior() : mHandle(nullptr) {}
+	explicit Behavior(Handle handle) : mHandle(handle) {}
+	Behavior(Behavior&& other) noexcept;
+	Behavior& operator=(Behavior&& other) noexcept;
+	~Behavior();
+
+	Behavior(const Behavior&) = delete;
+	Behavior& operator=(const Behavior&) = delete;
+
+	Handle GetHandle() const {
+		return mHandle;
+	}
+	bool IsDone() const {
+		return !mHandle || mHandle.done();
+	}
+
+private:
+	void Destroy();
+
+	Handle mHandle;
+};
+
+// co_await Seconds(t): resume after t seconds of game time (on the gameplay timer wheel)
+struct Seconds {
+	explicit Seconds(float seconds) : mSeconds(seconds) {}
+
+	bool await_ready() const {
+		return mSeconds <= 0.0f;
+	}
+	void await_suspend(Behavior::Handle handle);
+	void await_resume() {}
+
+	float mSeconds;
+};
+
+// co_await Until(condition): resume once condition returns true
+// (checked right away, then at ~10 Hz - see BehaviorScheduler; pass everyFrame for conditions
+// that can be true for only a few frames, e.g. passing a point)
+struct Until {
+	explicit Until(std::function<bool()> condition, bool everyFrame = false)
+		: mCondition(std::move(condition)), mEveryFrame(everyFrame) {}
+
+	bool await_ready() const {
+		return mCondition();
+	}
+	void await_suspend(Behavior::Handle handle);
+	void await_resume() {}
+
+	std::function<bool()> mCondition;
+	bool mEveryFrame;
+};
+
+// resumes behaviours that are ready, once per frame
+// - Seconds waits are timers on the TimerWheel, which queue the behaviour when they fire
+// - Until conditions are spread over NumConditionBuckets buckets and one bucket is checked per frame,
+//   so each condition is polled at ~10 Hz and the cost is even across frames (every-frame conditions
+//   have a bucket of their own that is checked on every Update)
+class BehaviorScheduler {
+public:
+	BehaviorScheduler(class TimerWheel* timers);
+
+	// queue a new behaviour to start on the next Update
+	void Start(Behavior::Handle handle);
+	void WaitFor(Behavior::Handle handle, float seconds);
+	void WaitUntil(Behavior::Handle handle, std::function<bool()> condition, bool everyFrame);
+	// stop waiting for whatever the behaviour is suspended on (before it's destroyed)
+	void Cancel(Behavior::Handle handle);
+
+	// check this frame's conditions and resume every ready behaviour (call after the timers advance)
+	void Update();
+
+	static const uint32_t NumConditionBuckets = 6;
+
+private:
+	struct Condition {
+		Behavior::Handle mHandle;
+		std::function<bool()> mCondition;
+	};
+
+	void MakeReady(Behavior::Handle handle);
+	// make ready (and remove) every condition of the bucket that holds
+	void CheckConditions(std::vector<Condition>& conditions);
+
+	// bucket of the conditions checked every frame
+	static const uint32_t EveryFrameBucket = NumConditionBuckets;
+
+	class TimerWheel* mTimers;
+	std::vector<Behavior::Handle> mReady;
+	// the behaviours being resumed by Update (ones made ready meanwhile wait for the next frame)
+	std::vector<Behavior::Handle> mResuming;
+	std::vector<Condition> mConditions[NumConditionBuckets + 1];
+	// bucket for the next condition (round robin)
+	uint32_t mNextBucket;
+	uint32_t mFrame;
+};
@@ -0,0 +1,14 @@
+#include "BehaviorComponent.hpp"
+#include "Actor.hpp"
+#include "Game.hpp"
+
+BehaviorComponent::BehaviorComponent(Actor* owner) : Component(owner) {
+	SetUpdateRate(EOnDemand);
+}
+
+void BehaviorComponent::Run(Behavior&& behavior) {
+	mBehavior = std::move(behavior);
+	if (mBehavior.GetHandle()) {
+		mOwner->GetGame()->GetBehaviors()->Start(mBehavior.GetHandle());
+	}
+}
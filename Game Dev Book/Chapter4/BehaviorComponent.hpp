@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Component.hpp"
+#include "Behavior.hpp"
+
+// runs a coroutine behaviour for its actor (the behaviour is resumed by the game's BehaviorScheduler,
+// so the component itself never updates)
+class BehaviorComponent : public Component {
+public:
+	BehaviorComponent(class Actor* owner);
+
+	// start a behaviour, replacing (and cancelling) the one running
+	void Run(Behavior&& behavior);
+
+	bool IsDone() const {
+		return mBehavior.IsDone();
+	}
+
+private:
+	Behavior mBehavior;
+};
@@ -4,6 +4,7 @@
 #include "CircleComponent.hpp"
 #include "Game.hpp"
 #include "Enemy.hpp"
+#include "TimerWheel.hpp"
 
 Bullet::Bullet(Game* game) : Actor(game) {
 	SpriteComponent* sc = new SpriteComponent(this);
@@ -15,7 +16,14 @@ Bullet::Bullet(Game* game) : Actor(game) {
 	mCircle = new CircleComponent(this);
 	mCircle->SetRadius(5.0f);
 
-	mLiveTime = 1.0f;
+	// time limit, die
+	mLiveTimer = game->GetTimers()->Schedule(1.0f, [this]() {
+		SetState(EDead);
+	});
+}
+
+Bullet::~Bullet() {
+	GetGame()->GetTimers()->Cancel(mLiveTimer);
 }
 
 void Bullet::UpdateActor(float deltaTime) {
@@ -30,10 +38,4 @@ void Bullet::UpdateActor(float deltaTime) {
 			break;
 		}
 	}
-
-	mLiveTime -= deltaTime;
-	if (mLiveTime <= 0.0f) {
-		// time limit hit, die
-		SetState(EDead);
-	}
 }
\ No newline at end of file
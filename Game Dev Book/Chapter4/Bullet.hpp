@@ -1,14 +1,17 @@
 #pragma once
 
 #include "Actor.hpp"
+#include "TimerWheel.hpp"
 
 class Bullet : public Actor {
 public:
 	Bullet(class Game* game);
+	~Bullet();
 	
 	void UpdateActor(float deltaTime) override;
 
 private:
 	class CircleComponent* mCircle;
-	float mLiveTime;
+	// kills the bullet when it runs out
+	TimerHandle mLiveTimer;
 };
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 CircleComponent::CircleComponent(Actor* owner) : Component(owner) {
 	mRadius = 0.0f;
+	// only queried for collisions, nothing to update
+	SetUpdateRate(EOnDemand);
 }
 
 const Vector2& CircleComponent::GetCenter() const {
@@ -1,9 +1,20 @@
 #include "Component.hpp"
 #include "Actor.hpp"
 
+namespace {
+	// frames between updates for each rate (0 for on demand)
+	const uint32_t sUpdateIntervals[Component::NumUpdateRates] = { 1, 2, 6, 30, 0 };
+	// phase handed to the next component set to each rate (round robin over the interval)
+	uint32_t sNextPhase[Component::NumUpdateRates] = {};
+}
+
 Component::Component(Actor* owner, int updateOrder) {
 	mOwner = owner;
 	mUpdateOrder = updateOrder;
+	mUpdateRate = EEveryFrame;
+	mPhase = 0;
+	mPendingTime = 0.0f;
+	mUpdateRequested = false;
 
 	// add to actor's vector of components
 	owner->AddComponent(this);
@@ -17,4 +28,35 @@ Component::~Component() {
 
 void Component::Update(float deltaTime) {
 
+}
+
+void Component::SetUpdateRate(UpdateRate rate) {
+	mUpdateRate = rate;
+	mPhase = 0;
+
+	uint32_t interval = sUpdateIntervals[rate];
+	if (interval > 1) {
+		mPhase = sNextPhase[rate];
+		sNextPhase[rate] = (sNextPhase[rate] + 1) % interval;
+	}
+}
+
+void Component::Tick(uint32_t frame, float deltaTime) {
+	mPendingTime += deltaTime;
+
+	bool due = false;
+	if (mUpdateRate == EOnDemand) {
+		due = mUpdateRequested;
+	}
+	else {
+		due = frame % sUpdateIntervals[mUpdateRate] == mPhase;
+	}
+
+	if (due) {
+		// pass on all the time since the last update, so rates don't change how fast things move
+		float elapsed = mPendingTime;
+		mPendingTime = 0.0f;
+		mUpdateRequested = false;
+		Update(elapsed);
+	}
 }
\ No newline at end of file
@@ -1,9 +1,25 @@
 #pragma once
 
 #include <cstdint>
+#include "PoolAllocator.hpp"
 
 class Component {
+	// actors/components of every type come from the size-class pools
+	DECLARE_POOL_ALLOCATED()
+
 public:
+	// how often Update runs (the game is capped at ~60 fps, so the reduced rates are frame intervals)
+	// components on a reduced rate are given staggered phases, so e.g. the 10 Hz ones are spread
+	// over 6 frames instead of all updating on the same frame
+	enum UpdateRate {
+		EEveryFrame,
+		E30Hz,
+		E10Hz,
+		E2Hz,
+		EOnDemand,  // only on the frame after RequestUpdate()
+		NumUpdateRates
+	};
+
 	// constructor
 	// (the lower the update order, the earlier the component updates)
 	Component(class Actor* owner, int updateOrder = 100);
@@ -20,10 +36,34 @@ public:
 		return mUpdateOrder;
 	}
 
+	UpdateRate GetUpdateRate() const {
+		return mUpdateRate;
+	}
+	void SetUpdateRate(UpdateRate rate);
+	// have an EOnDemand component update next frame
+	// (with the time since the request, not everything gathered while it sat idle)
+	void RequestUpdate() {
+		if (!mUpdateRequested) {
+			mPendingTime = 0.0f;
+			mUpdateRequested = true;
+		}
+	}
+
+	// called by the owning actor every frame, calls Update (with the time since the last one) when due
+	void Tick(uint32_t frame, float deltaTime);
+
 protected:
 	// owning actor
 	class Actor* mOwner;
 
 	// update order of component
 	int mUpdateOrder;
+
+private:
+	UpdateRate mUpdateRate;
+	// frame (modulo the rate's interval) this component updates on
+	uint32_t mPhase;
+	// delta time gathered since the last Update
+	float mPendingTime;
+	bool mUpdateRequested;
 };
\ No newline at end of file
@@ -5,9 +5,7 @@
 #include "Grid.hpp"
 #include "Tile.hpp"
 #include "CircleComponent.hpp"
-#include "AIComponent.hpp"
-#include "AIEnemyMoveState.hpp"
-#include "AIEnemyDeathState.hpp"
+#include "BehaviorComponent.hpp"
 #include <algorithm>
 
 Enemy::Enemy(class Game* game) : Actor(game) {
@@ -29,11 +27,8 @@ Enemy::Enemy(class Game* game) : Actor(game) {
 	mCircle = new CircleComponent(this);
 	mCircle->SetRadius(25.0f);
 
-	// Exercise 4.1
-	mAI = new AIComponent(this);
-	mAI->RegisterState(new AIEnemyMoveState(mAI));
-	mAI->RegisterState(new AIEnemyDeathState(mAI));
-	mAI->ChangeState("Move");
+	mBehavior = new BehaviorComponent(this);
+	mBehavior->Run(ReachEnd());
 }
 
 Enemy::~Enemy() {
@@ -42,3 +37,13 @@ Enemy::~Enemy() {
 	GetGame()->GetEnemies().erase(iter);
 	Actor::~Actor();
 }
+
+Behavior Enemy::ReachEnd() {
+	// the nav component moves us, just wait until we're at the end tile
+	// (checked every frame: at our speed we'd pass through the window between ~10 Hz checks)
+	co_await Until([this]() {
+		Vector2 diff = GetPosition() - GetGame()->GetGrid()->GetEndTile()->GetPosition();
+		return Math::NearZero(diff.Length(), 10.0f);
+	}, true);
+	SetState(EDead);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Actor.hpp"
+#include "Behavior.hpp"
 
 class Enemy : public Actor {
 public:
@@ -12,6 +13,9 @@ public:
 	}
 
 private:
+	// follow the path until the end tile, then die
+	Behavior ReachEnd();
+
 	class CircleComponent* mCircle;
-	class AIComponent* mAI;
+	class BehaviorComponent* mBehavior;
 };
\ No newline at end of file
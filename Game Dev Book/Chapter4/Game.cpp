@@ -1,5 +1,8 @@
 #include "Game.hpp"
 #include "Actor.hpp"
+#include "PoolAllocator.hpp"
+#include "FrameAllocator.hpp"
+#include "Profiler.hpp"
 #include "SpriteComponent.hpp"
 #include "SDL_image.h"
 #include "AIComponent.hpp"
@@ -8,6 +11,9 @@
 #include "AIDeath.hpp"
 #include "Grid.hpp"
 #include "Enemy.hpp"
+#include "TimerWheel.hpp"
+#include "Behavior.hpp"
+#include "MemoryTracker.hpp"
 #include <algorithm>
 
 Game::Game() {
@@ -16,6 +22,9 @@ Game::Game() {
     mRenderer = nullptr;
     mUpdatingActors = false;
     mTicksCount = 0;
+    mFrameNumber = 0;
+    mTimers = new TimerWheel();
+    mBehaviors = new BehaviorScheduler(mTimers);
 }
 
 bool Game::Initialize() {
@@ -60,11 +69,19 @@ bool Game::Initialize() {
 
     mTicksCount = SDL_GetTicks();
 
+    MemoryTracker::SetReportInterval(MemoryReportFrames);
+
     return true;
 }
 
 void Game::RunLoop() {
     while (mIsRunning) {
+        PROFILE_FRAME();
+        // release last frame's scratch memory
+        FrameAllocator::ResetAll();
+        // close out last frame's memory churn
+        MemoryTracker::EndFrame();
+
         ProcessInput();
         UpdateGame();
         GenerateOutput();
@@ -72,7 +89,22 @@ void Game::RunLoop() {
 }
 
 void Game::ShutDown() {
+#ifdef ENABLE_PROFILER
+    // dump whatever is still in the profiler's buffers
+    if (!Profiler::WriteChromeTrace("profile.json", 0, Profiler::GetFrame())) {
+        SDL_Log("Failed to write profile.json");
+    }
+#endif
+
     UnloadData();
+    // actors cancel their own timers/behaviours, so this goes after them
+    delete mBehaviors;
+    mBehaviors = nullptr;
+    delete mTimers;
+    mTimers = nullptr;
+    PoolAllocator::LogStats();
+    // anything still live outside Untagged now is a leak
+    MemoryTracker::LogReport();
     IMG_Quit();
     SDL_DestroyWindow(mWindow);
     SDL_DestroyRenderer(mRenderer);
@@ -109,6 +141,8 @@ void Game::RemoveActor(Actor* actor) {
 }
 
 void Game::LoadData() {
+    MEMORY_TAG_SCOPE(EActors);
+
     mGrid = new Grid(this);
 
     /*
@@ -156,6 +190,7 @@ void Game::UnloadData() {
 
     // destroy textures
     for (auto i : mTextureMap) {
+        MemoryTracker::RemoveExternal(MemoryTracker::ETexture, GetTextureBytes(i.second));
         SDL_DestroyTexture(i.second);
     }
     mTextureMap.clear();
@@ -184,6 +219,8 @@ void Game::RemoveSprite(SpriteComponent* sprite) {
 }
 
 SDL_Texture* Game::GetTexture(const std::string& fileName) {
+    MEMORY_TAG_SCOPE(ETexture);
+
     // is the texture already in the map?
     if (mTextureMap.find(fileName) == mTextureMap.end()) {
         // load from file
@@ -202,13 +239,24 @@ SDL_Texture* Game::GetTexture(const std::string& fileName) {
         }
 
         mTextureMap.emplace(fileName, text);
+        MemoryTracker::AddExternal(MemoryTracker::ETexture, GetTextureBytes(text));
         return text;
     }
 
     return mTextureMap.find(fileName)->second;
 }
 
+int64_t Game::GetTextureBytes(SDL_Texture* texture) {
+    // estimate, assuming the renderer keeps 4 bytes per pixel
+    int width = 0;
+    int height = 0;
+    SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+    return static_cast<int64_t>(width) * height * 4;
+}
+
 void Game::ProcessInput() {
+    PROFILE_SCOPE("Game::ProcessInput");
+
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         switch (event.type) {
@@ -258,6 +306,14 @@ void Game::UpdateGame() {
     }
 
     mTicksCount = SDL_GetTicks();
+    mFrameNumber += 1;
+
+    PROFILE_SCOPE("Game::UpdateGame");
+
+    // fire any timers that came due (lifetimes, spawns, cooldowns)
+    mTimers->Advance(deltaTime);
+    // resume the behaviours whose wait is over
+    mBehaviors->Update();
 
     // update all actors
     mUpdatingActors = true;
@@ -273,7 +329,7 @@ void Game::UpdateGame() {
     mPendingActors.clear();
 
     // add any dead actors to a temp vector
-    std::vector<Actor*> deadActors;
+    FrameVector<Actor*> deadActors;
     for (auto actor : mActors) {
         if (actor->GetState() == Actor::EDead) {
             deadActors.emplace_back(actor);
@@ -287,6 +343,9 @@ void Game::UpdateGame() {
 }
 
 void Game::GenerateOutput() {
+    PROFILE_SCOPE("Game::GenerateOutput");
+    MEMORY_TAG_SCOPE(ERenderer);
+
     SDL_SetRenderDrawColor(
         mRenderer,
         34,
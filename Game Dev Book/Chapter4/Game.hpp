@@ -32,6 +32,20 @@ public:
 
     class Enemy* GetNearestEnemy(const Vector2& pos);
 
+    // number of frames updated so far (drives the component update rates)
+    uint32_t GetFrameNumber() const {
+        return mFrameNumber;
+    }
+
+    // gameplay timers (advanced once per frame, before actors update)
+    class TimerWheel* GetTimers() {
+        return mTimers;
+    }
+    // resumes coroutine behaviours (after the timers advance)
+    class BehaviorScheduler* GetBehaviors() {
+        return mBehaviors;
+    }
+
 private:
     void ProcessInput();
     void UpdateGame();
@@ -40,11 +54,18 @@ private:
     void LoadData();
     void UnloadData();
 
+    // GPU memory estimate of a texture, for the MemoryTracker
+    int64_t GetTextureBytes(SDL_Texture* texture);
+
+    // frames between memory reports
+    const uint32_t MemoryReportFrames = 600;
+
 private:
     SDL_Window* mWindow;
     bool mIsRunning;
     SDL_Renderer* mRenderer;
     Uint32 mTicksCount;
+    uint32_t mFrameNumber;
 
     // all the actors in the game
     std::vector<class Actor*> mActors;
@@ -60,6 +81,9 @@ private:
     // all the sprite components drawn
     std::vector<class SpriteComponent*> mSprites;
 
+    class TimerWheel* mTimers;
+    class BehaviorScheduler* mBehaviors;
+
     // game-specific
     std::vector<class Enemy*> mEnemies;
     class Grid* mGrid;
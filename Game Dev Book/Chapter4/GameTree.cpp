@@ -2,11 +2,20 @@
 #include <iostream>
 #include <limits>
 #include <algorithm>
+#include "MemoryTracker.hpp"
 
 Minimax::Minimax() {
 
 }
 
+// free a game tree made by GenerateStates, root node included
+void Minimax::DeleteStates(GTNode* root) {
+	for (GTNode* child : root->mChildren) {
+		DeleteStates(child);
+	}
+	delete root;
+}
+
 // generate a game tree starting from root node for a game of tic-tac-toe
 void Minimax::GenerateStates(GTNode* root, bool xPlayer) {
 	for (int i = 0; i < 3; ++i) {
@@ -291,13 +300,14 @@ bool Minimax::IsTerminal(const GameState& state) {
 	return false;
 }
 
-std::vector<const GameState*> Minimax::GetPossibleMoves(const GameState& state) {
+FrameVector<const GameState*> Minimax::GetPossibleMoves(const GameState& state) {
 	// placeholder for finding a vector of game states that are one move after the 
 	// current state
 	return {};
 }
 
 void Minimax::TestTicTacToe() {
+	MEMORY_TAG_SCOPE(EAI);
 	GTNode* root = new GTNode;
 	root->mState.mBoard[0][0] = GameState::O;
 	root->mState.mBoard[0][1] = GameState::Empty;
@@ -312,4 +322,6 @@ void Minimax::TestTicTacToe() {
 	GenerateStates(root, true);
 	const GTNode* choice = AlphaBetaDecide(root);
 	std::cout << choice->mChildren.size();
+
+	DeleteStates(root);
 }
\ No newline at end of file
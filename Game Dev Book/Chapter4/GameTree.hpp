@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include "FrameAllocator.hpp"
 
 // tic-tac-toe
 struct GameState {
@@ -47,9 +48,10 @@ public:
 
 	// helper functions
 	void GenerateStates(GTNode* root, bool xPlayer);
+	void DeleteStates(GTNode* root);  // delete a tree made by GenerateStates (including root)
 	float GetScore(const GameState& state);  
 	bool IsTerminal(const GameState& state);
-	std::vector<const GameState*> GetPossibleMoves(const GameState& state);
+	FrameVector<const GameState*> GetPossibleMoves(const GameState& state);  // result lives in the frame arena
 
 	void TestTicTacToe();
 };
\ No newline at end of file
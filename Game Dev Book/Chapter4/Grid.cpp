@@ -3,6 +3,10 @@
 #include "Tower.hpp"
 #include "Enemy.hpp"
 #include <algorithm>
+#include "FrameAllocator.hpp"
+#include "Profiler.hpp"
+#include "Game.hpp"
+#include "MemoryTracker.hpp"
 
 Grid::Grid(class Game* game) : Actor(game) {
 	mSelectedTile = nullptr;
@@ -47,7 +51,14 @@ Grid::Grid(class Game* game) : Actor(game) {
 	FindPath(GetEndTile(), GetStartTile());
 	UpdatePathTiles(GetStartTile());
 
-	mNextEnemy = EnemyTime;
+	// spawn enemies on a repeating timer, so the grid doesn't need to update every frame
+	mEnemyTimer = game->GetTimers()->Schedule(EnemyTime, [this]() {
+		new Enemy(GetGame());
+	}, EnemyTime);
+}
+
+Grid::~Grid() {
+	GetGame()->GetTimers()->Cancel(mEnemyTimer);
 }
 
 void Grid::SelectTile(size_t row, size_t col) {
@@ -79,6 +90,9 @@ void Grid::ProcessClick(int x, int y) {
 
 // implements A* pathfinding
 bool Grid::FindPath(Tile* start, Tile* goal) {
+	PROFILE_SCOPE("Grid::FindPath");
+	MEMORY_TAG_SCOPE(EAI);
+
 	for (size_t i = 0; i < NumRows; ++i) {
 		for (size_t j = 0; j < NumCols; ++j) {
 			mTiles[i][j]->g = 0.0f;
@@ -87,7 +101,7 @@ bool Grid::FindPath(Tile* start, Tile* goal) {
 		}
 	}
 
-	std::vector<Tile*> openSet;
+	FrameVector<Tile*> openSet;
 
 	// set current node to start, and add to closed set
 	Tile* current = start;
@@ -192,14 +206,3 @@ Tile* Grid::GetStartTile() {
 Tile* Grid::GetEndTile() {
 	return mTiles[3][15];
 }
-
-void Grid::UpdateActor(float deltaTime) {
-	Actor::UpdateActor(deltaTime);
-
-	// is it time to spawn a new enemy?
-	mNextEnemy -= deltaTime;
-	if (mNextEnemy <= 0.0f) {
-		new Enemy(GetGame());
-		mNextEnemy += EnemyTime;
-	}
-}
\ No newline at end of file
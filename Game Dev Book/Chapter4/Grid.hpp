@@ -1,11 +1,13 @@
 #pragma once
 
 #include "Actor.hpp"
+#include "TimerWheel.hpp"
 #include <vector>
 
 class Grid : public Actor {
 public:
 	Grid(class Game* game);
+	~Grid();
 
 	// handle a mouse click at the x/y screen locations
 	void ProcessClick(int x, int y);
@@ -20,8 +22,6 @@ public:
 	class Tile* GetStartTile();
 	class Tile* GetEndTile();
 
-	void UpdateActor(float deltaTime) override;
-
 private:
 	// select a specific tile
 	void SelectTile(size_t row, size_t col);
@@ -35,8 +35,8 @@ private:
 	// 2D vector of tiles in grid
 	std::vector<std::vector<class Tile*>> mTiles;
 
-	// time until next enemy
-	float mNextEnemy;
+	// spawns an enemy every EnemyTime seconds
+	TimerHandle mEnemyTimer;
 
 	// rows/columns in grid
 	const size_t NumRows = 7;
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// tracks memory by subsystem, to set budgets and catch leaks
+// - every heap allocation (global operator new) is charged to the calling thread's current tag, set for a
+//   scope with MEMORY_TAG_SCOPE(ETexture) etc (anything outside a scope is EUntagged)
+// - a small header in front of each allocation remembers its tag and size, so a free is charged back to
+//   the tag that allocated it, wherever it happens
+// - memory that isn't on our heap (SDL textures) is reported with AddExternal/RemoveExternal
+// - per tag: live bytes, peak, allocation/free counts, per-frame churn and an optional budget
+// - EndFrame (once per frame) closes the frame's churn, warns about tags going over budget and logs the
+//   report every SetReportInterval frames
+class MemoryTracker {
+public:
+	enum Tag {
+		EUntagged,
+		ERenderer,
+		EMesh,
+		ETexture,
+		EAudio,
+		EActors,
+		EAI,
+		EScratch,
+		NumTags
+	};
+
+	struct Stats {
+		int64_t mLiveBytes;  // heap bytes allocated and not freed yet
+		int64_t mPeakBytes;
+		int64_t mExternalBytes;  // GPU memory etc, not on our heap
+		uint64_t mAllocations;
+		uint64_t mFrees;
+		// churn of the last finished frame
+		int64_t mFrameAllocations;
+		int64_t mFrameBytes;
+		int64_t mBudget;  // live + external bytes allowed (0 for no budget)
+	};
+
+	// tagged heap allocation (what operator new uses)
+	static void* Allocate(size_t size, Tag tag);
+	// ptr may be null; keeps the block's tag
+	static void* Reallocate(void* ptr, size_t size, Tag tag);
+	static void Free(void* ptr);
+
+	static void AddExternal(Tag tag, int64_t bytes);
+	static void RemoveExternal(Tag tag, int64_t bytes);
+
+	// tag of the calling thread
+	static Tag GetCurrentTag();
+	static void SetCurrentTag(Tag tag);
+
+	static Stats GetStats(Tag tag);
+	static const char* GetTagName(Tag tag);
+	static void SetBudget(Tag tag, int64_t bytes);
+	// 0 turns the periodic report off
+	static void SetReportInterval(uint32_t frames);
+
+	static void EndFrame();
+	// log every tag's stats
+	static void LogReport();
+};
+
+// charges the allocations of the rest of the enclosing scope (on this thread) to a tag
+class MemoryTagScope {
+public:
+	MemoryTagScope(MemoryTracker::Tag tag) {
+		mPrevious = MemoryTracker::GetCurrentTag();
+		MemoryTracker::SetCurrentTag(tag);
+	}
+	~MemoryTagScope() {
+		MemoryTracker::SetCurrentTag(mPrevious);
+	}
+
+private:
+	MemoryTracker::Tag mPrevious;
+};
+
+#define MEMORY_CONCAT_INNER(a, b) a##b
+#define MEMORY_CONCAT(a, b) MEMORY_CONCAT_INNER(a, b)
+#define MEMORY_TAG_SCOPE(tag) MemoryTagScope MEMORY_CONCAT(memoryTagScope, __LINE__)(MemoryTracker::tag)
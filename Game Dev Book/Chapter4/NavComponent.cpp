@@ -22,10 +22,17 @@ void NavComponent::Update(float deltaTime) {
 		Vector2 diff = mOwner->GetPosition() - mNextNode->GetPosition();
 		if (Math::NearZero(diff.Length(), 2.0f)) {
 			mNextNode = mNextNode->GetParent();
-			TurnTo(mNextNode->GetPosition());
+			if (mNextNode) {
+				TurnTo(mNextNode->GetPosition());
+			}
 		}
 	}
-	
+
+	// at the end of the path (or without one), stay put
+	if (!mNextNode) {
+		return;
+	}
+
 	// this moves the actor forward
 	MoveComponent::Update(deltaTime);
 }
@@ -33,5 +40,7 @@ void NavComponent::Update(float deltaTime) {
 void NavComponent::StartPath(const Tile* start) {
 	// initialize mNextNode to the next node in the path and rotate this actor to face that node
 	mNextNode = start->GetParent();
-	TurnTo(mNextNode->GetPosition());
+	if (mNextNode) {
+		TurnTo(mNextNode->GetPosition());
+	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <algorithm>
 #include <limits>
+#include "MemoryTracker.hpp"
 
 Pathfinder::Pathfinder() {
 	// assume we have a Graph g, we can run BFS between two GraphNodes in the graph
@@ -233,6 +234,7 @@ float Pathfinder::ComputeHeuristic(const WeightedGraphNode* node, const Weighted
 }
 
 void Pathfinder::TestBFS() {
+	MEMORY_TAG_SCOPE(EAI);
 	Graph g;
 	for (int i = 0; i < 5; ++i) {
 		for (int j = 0; j < 5; ++j) {
@@ -262,9 +264,15 @@ void Pathfinder::TestBFS() {
 	NodeToParentMap map;
 	bool found = BFS(g, g.mNodes[0], g.mNodes[9], map);
 	std::cout << found << '\n';
+
+	// the graph owns its nodes
+	for (GraphNode* node : g.mNodes) {
+		delete node;
+	}
 }
 
 void Pathfinder::TestHeuristic(bool useAStar) {
+	MEMORY_TAG_SCOPE(EAI);
 	WeightedGraph g;
 	for (int i = 0; i < 5; ++i) {
 		for (int j = 0; j < 5; ++j) {
@@ -317,4 +325,12 @@ void Pathfinder::TestHeuristic(bool useAStar) {
 		found = GBFS(g, g.mNodes[0], g.mNodes[9], map);
 	}
 	std::cout << found << '\n';
+
+	// the graph owns its nodes, and each node its outgoing edges
+	for (WeightedGraphNode* node : g.mNodes) {
+		for (WeightedEdge* edge : node->mEdges) {
+			delete edge;
+		}
+		delete node;
+	}
 }
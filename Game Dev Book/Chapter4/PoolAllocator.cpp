@@ -0,0 +1,118 @@
+#include "PoolAllocator.hpp"
+#include "SDL.h"
+#include <new>
+#include "MemoryTracker.hpp"
+
+PoolAllocator::PoolAllocator() {
+	for (size_t i = 0; i < NumSizeClasses; ++i) {
+		mClasses[i].mFreeList = nullptr;
+		mClasses[i].mStats.mBlockSize = (i + 1) * Granularity;
+		mClasses[i].mStats.mAllocations = 0;
+		mClasses[i].mStats.mRecycled = 0;
+		mClasses[i].mStats.mFrees = 0;
+		mClasses[i].mStats.mLive = 0;
+		mClasses[i].mStats.mPeakLive = 0;
+		mClasses[i].mStats.mCapacity = 0;
+	}
+}
+
+PoolAllocator::~PoolAllocator() {
+	for (auto& sizeClass : mClasses) {
+		for (auto chunk : sizeClass.mChunks) {
+			::operator delete(chunk);
+		}
+	}
+}
+
+PoolAllocator& PoolAllocator::Get() {
+	// function-local so it exists before the first allocation, even from another static's constructor
+	static PoolAllocator allocator;
+	return allocator;
+}
+
+void* PoolAllocator::Allocate(size_t size) {
+	// the pools hold actors and components (and behaviour coroutine frames), charged to EActors
+	MEMORY_TAG_SCOPE(EActors);
+	if (size == 0 || size > MaxPooledSize) {
+		return ::operator new(size);
+	}
+
+	SizeClass& sizeClass = Get().mClasses[(size - 1) / Granularity];
+	if (sizeClass.mFreeList == nullptr) {
+		Get().Grow(sizeClass);
+	}
+	else if (sizeClass.mStats.mFrees > sizeClass.mStats.mRecycled) {
+		// freed blocks are pushed on the front of the list (and we only grow once it's empty),
+		// so while there are freed blocks that haven't been reused, the front block is one of them
+		sizeClass.mStats.mRecycled += 1;
+	}
+
+	// pop the first free block
+	FreeBlock* block = sizeClass.mFreeList;
+	sizeClass.mFreeList = block->mNext;
+
+	sizeClass.mStats.mAllocations += 1;
+	sizeClass.mStats.mLive += 1;
+	if (sizeClass.mStats.mLive > sizeClass.mStats.mPeakLive) {
+		sizeClass.mStats.mPeakLive = sizeClass.mStats.mLive;
+	}
+
+	return block;
+}
+
+void PoolAllocator::Free(void* ptr, size_t size) {
+	if (ptr == nullptr) {
+		return;
+	}
+	if (size == 0 || size > MaxPooledSize) {
+		::operator delete(ptr);
+		return;
+	}
+
+	// push the block back onto the free list
+	SizeClass& sizeClass = Get().mClasses[(size - 1) / Granularity];
+	FreeBlock* block = static_cast<FreeBlock*>(ptr);
+	block->mNext = sizeClass.mFreeList;
+	sizeClass.mFreeList = block;
+
+	sizeClass.mStats.mFrees += 1;
+	sizeClass.mStats.mLive -= 1;
+}
+
+void PoolAllocator::Grow(SizeClass& sizeClass) {
+	const size_t blockSize = sizeClass.mStats.mBlockSize;
+	const size_t numBlocks = ChunkBytes / blockSize;
+
+	unsigned char* chunk = static_cast<unsigned char*>(::operator new(numBlocks * blockSize));
+	sizeClass.mChunks.emplace_back(chunk);
+
+	// link the blocks together in address order, so allocations walk the chunk front to back
+	for (size_t i = numBlocks; i > 0; --i) {
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize);
+		block->mNext = sizeClass.mFreeList;
+		sizeClass.mFreeList = block;
+	}
+
+	sizeClass.mStats.mCapacity += numBlocks;
+}
+
+std::vector<PoolAllocator::Stats> PoolAllocator::GetStats() {
+	std::vector<Stats> stats;
+	for (const auto& sizeClass : Get().mClasses) {
+		if (sizeClass.mStats.mAllocations > 0) {
+			stats.emplace_back(sizeClass.mStats);
+		}
+	}
+	return stats;
+}
+
+void PoolAllocator::LogStats() {
+	for (const Stats& s : GetStats()) {
+		SDL_Log("Pool %4zu bytes: %llu allocs (%llu recycled), %llu frees, %zu live, %zu peak, %zu capacity",
+			s.mBlockSize,
+			static_cast<unsigned long long>(s.mAllocations),
+			static_cast<unsigned long long>(s.mRecycled),
+			static_cast<unsigned long long>(s.mFrees),
+			s.mLive, s.mPeakLive, s.mCapacity);
+	}
+}
@@ -0,0 +1,114 @@
+#include "Profiler.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+	struct Event {
+		const char* mName;
+		uint64_t mStart;
+		uint64_t mEnd;
+		uint32_t mFrame;
+	};
+
+	// ring buffer written only by its own thread
+	struct ThreadBuffer {
+		std::vector<Event> mEvents;
+		// total events ever written (the slot is mCount % BufferSize), published after the event is written
+		std::atomic<uint64_t> mCount;
+		uint32_t mThreadId;
+	};
+
+	const std::chrono::steady_clock::time_point sStartTime = std::chrono::steady_clock::now();
+	std::atomic<uint32_t> sFrame(0);
+
+	// buffers are owned here rather than by the threads, so they outlive threads that exit
+	std::mutex sBuffersMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> sBuffers;
+
+	ThreadBuffer* CreateThreadBuffer() {
+		std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+		buffer->mEvents.resize(Profiler::BufferSize);
+		buffer->mCount = 0;
+
+		std::lock_guard<std::mutex> lock(sBuffersMutex);
+		buffer->mThreadId = static_cast<uint32_t>(sBuffers.size());
+		sBuffers.emplace_back(std::move(buffer));
+		return sBuffers.back().get();
+	}
+
+	ThreadBuffer& GetThreadBuffer() {
+		static thread_local ThreadBuffer* buffer = CreateThreadBuffer();
+		return *buffer;
+	}
+}
+
+uint64_t Profiler::GetTime() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - sStartTime).count();
+}
+
+void Profiler::BeginFrame() {
+	sFrame.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t Profiler::GetFrame() {
+	return sFrame.load(std::memory_order_relaxed);
+}
+
+void Profiler::Record(const char* name, uint64_t start, uint64_t end) {
+	ThreadBuffer& buffer = GetThreadBuffer();
+	uint64_t count = buffer.mCount.load(std::memory_order_relaxed);
+
+	Event& e = buffer.mEvents[count % BufferSize];
+	e.mName = name;
+	e.mStart = start;
+	e.mEnd = end;
+	e.mFrame = GetFrame();
+
+	buffer.mCount.store(count + 1, std::memory_order_release);
+}
+
+bool Profiler::WriteChromeTrace(const std::string& fileName, uint32_t firstFrame, uint32_t lastFrame) {
+	std::ofstream file(fileName);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	// times are in microseconds, keep the nanoseconds as decimals
+	file << std::fixed << std::setprecision(3);
+	file << "{\"traceEvents\":[\n";
+
+	std::lock_guard<std::mutex> lock(sBuffersMutex);
+	bool first = true;
+	for (const auto& buffer : sBuffers) {
+		// name the thread's row
+		if (!first) {
+			file << ",\n";
+		}
+		first = false;
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->mThreadId
+			<< ",\"args\":{\"name\":\"Thread " << buffer->mThreadId << "\"}}";
+
+		// oldest event still in the ring, up to the newest
+		uint64_t count = buffer->mCount.load(std::memory_order_acquire);
+		uint64_t begin = count > BufferSize ? count - BufferSize : 0;
+		for (uint64_t i = begin; i < count; ++i) {
+			const Event& e = buffer->mEvents[i % BufferSize];
+			if (e.mFrame < firstFrame || e.mFrame > lastFrame) {
+				continue;
+			}
+
+			// complete event ("X"), with a start and a duration
+			file << ",\n{\"name\":\"" << e.mName << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->mThreadId
+				<< ",\"ts\":" << e.mStart / 1000.0 << ",\"dur\":" << (e.mEnd - e.mStart) / 1000.0
+				<< ",\"args\":{\"frame\":" << e.mFrame << "}}";
+		}
+	}
+
+	file << "\n]}\n";
+	return true;
+}
@@ -7,6 +7,8 @@ SpriteComponent::SpriteComponent(Actor* owner, int drawOrder) : Component(owner)
 	mTexture = nullptr;
 	mTexWidth = 0;
 	mTexHeight = 0;
+	// sprites are drawn by Game::GenerateOutput and have nothing to update
+	SetUpdateRate(EOnDemand);
 
 	mOwner->GetGame()->AddSprite(this);
 }
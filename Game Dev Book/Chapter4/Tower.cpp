@@ -2,19 +2,47 @@
 #include "SpriteComponent.hpp"
 #include "MoveComponent.hpp"
 #include "Game.hpp"
-#include "AIComponent.hpp"
-#include "AITowerRestState.hpp"
-#include "AITowerFireState.hpp"
+#include "BehaviorComponent.hpp"
+#include "Enemy.hpp"
+#include "Bullet.hpp"
+
+namespace {
+	// resumes once an enemy is within range of the actor
+	Until UntilEnemyInRange(Actor* actor, float range) {
+		return Until([actor, range]() {
+			Enemy* e = actor->GetGame()->GetNearestEnemy(actor->GetPosition());
+			return e != nullptr && (e->GetPosition() - actor->GetPosition()).LengthSq() < range * range;
+		});
+	}
+}
 
 Tower::Tower(Game* game) : Actor(game) {
 	SpriteComponent* sc = new SpriteComponent(this, 200);  // draw towers in front of everything
 	sc->SetTexture(game->GetTexture("Assets/Tower.png"));
 
 	mMove = new MoveComponent(this);
+	// towers only turn to face their target, which the fire state does directly
+	mMove->SetUpdateRate(Component::EOnDemand);
+
+	mBehavior = new BehaviorComponent(this);
+	mBehavior->Run(Attack());
+}
+
+Behavior Tower::Attack() {
+	while (true) {
+		// sleep until there's something to shoot at
+		co_await UntilEnemyInRange(this, AttackRange);
+
+		// rotate to face the nearest enemy
+		Enemy* e = GetGame()->GetNearestEnemy(GetPosition());
+		Vector2 dir = e->GetPosition() - GetPosition();
+		SetRotation(Math::Atan2(-dir.y, dir.x));
+
+		// spawn bullet at tower position facing enemy
+		Bullet* b = new Bullet(GetGame());
+		b->SetPosition(GetPosition());
+		b->SetRotation(GetRotation());
 
-	// Exercise 4.1
-	mAI = new AIComponent(this);
-	mAI->RegisterState(new AITowerRestState(mAI));
-	mAI->RegisterState(new AITowerFireState(mAI));
-	mAI->ChangeState("Rest");
+		co_await Seconds(AttackTime);
+	}
 }
@@ -1,12 +1,19 @@
 #pragma once
 
 #include "Actor.hpp"
+#include "Behavior.hpp"
 
 class Tower : public Actor {
 public:
 	Tower(class Game* game);
 
 private:
+	// wait for an enemy in range, shoot it, rest, repeat
+	Behavior Attack();
+
 	class MoveComponent* mMove;
-	class AIComponent* mAI;
+	class BehaviorComponent* mBehavior;
+
+	const float AttackTime = 2.5f;
+	const float AttackRange = 100.0f;
 };
\ No newline at end of file
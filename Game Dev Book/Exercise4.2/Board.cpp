@@ -9,8 +9,9 @@ BoardState::BoardState() {
 	}
 }
 
-std::vector<BoardState*> BoardState::GetPossibleMoves(SquareState player) const {
-	std::vector<BoardState*> retVal;
+FrameVector<BoardState*> BoardState::GetPossibleMoves(SquareState player) const {
+	FrameVector<BoardState*> retVal;
+	retVal.reserve(7);
 
 	// for each column, find if a move is possible
 	for (int col = 0; col < 7; ++col) {
@@ -267,7 +268,7 @@ void CPUMove(BoardState* state) {
 	
 	/*
 	// for now, this just randomly picks one of the possible moves
-	std::vector<BoardState*> moves = state->GetPossibleMoves(BoardState::Red);  // computer AI is Red
+	FrameVector<BoardState*> moves = state->GetPossibleMoves(BoardState::Red);  // computer AI is Red
 
 	int index = Random::GetIntRange(0, moves.size() - 1);
 
@@ -286,8 +287,11 @@ float AlphaBetaMaxLimit(const BoardState* state, int depth, float alpha, float b
 		return state->GetScore();
 	}
 
+	// the moves vector is scratch memory, so hand it back to the frame arena when this level returns
+	FrameScope scope;
+
 	float maxValue = -std::numeric_limits<float>::infinity();
-	std::vector<BoardState*> moves = state->GetPossibleMoves(BoardState::Red);
+	FrameVector<BoardState*> moves = state->GetPossibleMoves(BoardState::Red);
 
 	for (const BoardState* child : moves) {
 		maxValue = std::max(maxValue, AlphaBetaMinLimit(child, depth - 1, alpha, beta));
@@ -314,8 +318,11 @@ float AlphaBetaMinLimit(const BoardState* state, int depth, float alpha, float b
 		return state->GetScore();
 	}
 
+	// the moves vector is scratch memory, so hand it back to the frame arena when this level returns
+	FrameScope scope;
+
 	float minValue = std::numeric_limits<float>::infinity();
-	std::vector<BoardState*> moves = state->GetPossibleMoves(BoardState::Yellow);
+	FrameVector<BoardState*> moves = state->GetPossibleMoves(BoardState::Yellow);
 
 	for (const BoardState* child : moves) {
 		minValue = std::min(minValue, AlphaBetaMaxLimit(child, depth - 1, alpha, beta));
@@ -343,7 +350,7 @@ const BoardState* AlphaBetaDecideLimit(const BoardState* root, int maxDepth) {
 	float maxValue = -std::numeric_limits<float>::infinity();
 	float beta = std::numeric_limits<float>::infinity();
 
-	std::vector<BoardState*> moves = root->GetPossibleMoves(BoardState::Red);
+	FrameVector<BoardState*> moves = root->GetPossibleMoves(BoardState::Red);
 	for (BoardState* child : moves) {
 		float v = AlphaBetaMinLimit(child, maxDepth - 1, maxValue, beta);
 		if (v > maxValue) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include "FrameAllocator.hpp"
 
 class BoardState {
 public:
@@ -12,7 +13,7 @@ public:
 
 	BoardState();
 
-	std::vector<BoardState*> GetPossibleMoves(SquareState player) const;
+	FrameVector<BoardState*> GetPossibleMoves(SquareState player) const;  // vector lives in the frame arena (the states are heap allocated)
 	bool IsTerminal() const;
 	float GetScore() const;
 
@@ -0,0 +1,117 @@
+#include "FrameAllocator.hpp"
+#include <mutex>
+#include <algorithm>
+#include <new>
+
+namespace {
+	// guards the list of arenas (threads register/unregister their arena when it's created/destroyed)
+	std::mutex& GetArenasMutex() {
+		static std::mutex mutex;
+		return mutex;
+	}
+}
+
+FrameAllocator::FrameAllocator(size_t capacity) {
+	mBuffer = static_cast<unsigned char*>(::operator new(capacity));
+	mCapacity = capacity;
+	mOffset = 0;
+	mPeak = 0;
+	mSpilledBytes = 0;
+
+	std::lock_guard<std::mutex> lock(GetArenasMutex());
+	GetArenas().emplace_back(this);
+}
+
+FrameAllocator::~FrameAllocator() {
+	{
+		std::lock_guard<std::mutex> lock(GetArenasMutex());
+		std::vector<FrameAllocator*>& arenas = GetArenas();
+		auto iter = std::find(arenas.begin(), arenas.end(), this);
+		if (iter != arenas.end()) {
+			arenas.erase(iter);
+		}
+	}
+
+	for (auto ptr : mSpilled) {
+		::operator delete(ptr);
+	}
+	::operator delete(mBuffer);
+}
+
+FrameAllocator& FrameAllocator::Get() {
+	static thread_local FrameAllocator arena(DefaultCapacity);
+	return arena;
+}
+
+void FrameAllocator::ResetAll() {
+	std::lock_guard<std::mutex> lock(GetArenasMutex());
+	for (auto arena : GetArenas()) {
+		arena->Reset();
+	}
+}
+
+std::vector<FrameAllocator*>& FrameAllocator::GetArenas() {
+	static std::vector<FrameAllocator*> arenas;
+	return arenas;
+}
+
+void* FrameAllocator::Allocate(size_t size, size_t alignment) {
+	// round the offset up to the alignment (alignments are powers of 2)
+	size_t start = (mOffset + alignment - 1) & ~(alignment - 1);
+	if (start + size > mCapacity) {
+		// out of room, so use the heap for the rest of the frame
+		void* ptr = ::operator new(size);
+		mSpilled.emplace_back(ptr);
+		mSpilledBytes += size;
+		return ptr;
+	}
+
+	mOffset = start + size;
+	if (mOffset > mPeak) {
+		mPeak = mOffset;
+	}
+	return mBuffer + start;
+}
+
+void FrameAllocator::Free(void* ptr, size_t size) {
+	// only the top allocation can be given back
+	unsigned char* p = static_cast<unsigned char*>(ptr);
+	if (p >= mBuffer && p + size == mBuffer + mOffset) {
+		mOffset = p - mBuffer;
+	}
+}
+
+void FrameAllocator::Reset() {
+	for (auto ptr : mSpilled) {
+		::operator delete(ptr);
+	}
+	mSpilled.clear();
+
+	// the last frame didn't fit, so grow enough that it would have
+	if (mSpilledBytes > 0) {
+		size_t newCapacity = std::max(mCapacity * 2, mCapacity + mSpilledBytes);
+		::operator delete(mBuffer);
+		mBuffer = static_cast<unsigned char*>(::operator new(newCapacity));
+		mCapacity = newCapacity;
+		mSpilledBytes = 0;
+	}
+
+	mOffset = 0;
+}
+
+FrameAllocator::Marker FrameAllocator::GetMarker() const {
+	Marker marker;
+	marker.mOffset = mOffset;
+	marker.mNumSpilled = mSpilled.size();
+	return marker;
+}
+
+void FrameAllocator::FreeToMarker(const Marker& marker) {
+	mOffset = marker.mOffset;
+
+	// spilled allocations made since the marker can go too
+	while (mSpilled.size() > marker.mNumSpilled) {
+		::operator delete(mSpilled.back());
+		mSpilled.pop_back();
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// per-frame scratch memory (linear/bump allocator) for transient containers
+// - allocating just bumps an offset, and freeing individual allocations does nothing
+//   (except for the most recent allocation, so a growing vector can reuse its own space)
+// - everything is released at once by ResetAll(), which Game calls at the start of every frame,
+//   so nothing allocated here may be kept past the end of the frame
+// - each thread has its own arena, so allocating never takes a lock
+// - if an arena runs out, allocations spill over to the heap until the next reset, and the arena grows
+//   at that reset so the next frame fits
+class FrameAllocator {
+public:
+	// arena of the calling thread (created on first use)
+	static FrameAllocator& Get();
+	// reset every thread's arena (only while no other thread is allocating from its arena)
+	static void ResetAll();
+
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+	// only gives the memory back if it's the most recent allocation
+	void Free(void* ptr, size_t size);
+	// release everything allocated from this arena
+	void Reset();
+
+	// position in the arena, to rewind to later (see FrameScope)
+	struct Marker {
+		size_t mOffset;
+		size_t mNumSpilled;
+	};
+	Marker GetMarker() const;
+	// release everything allocated since the marker was taken
+	void FreeToMarker(const Marker& marker);
+
+	size_t GetUsed() const {
+		return mOffset;
+	}
+	size_t GetCapacity() const {
+		return mCapacity;
+	}
+	// highest usage since the arena was created
+	size_t GetPeak() const {
+		return mPeak;
+	}
+
+	static const size_t DefaultCapacity = 1024 * 1024;
+
+private:
+	FrameAllocator(size_t capacity);
+	~FrameAllocator();
+
+	// every thread's arena
+	static std::vector<FrameAllocator*>& GetArenas();
+
+	unsigned char* mBuffer;
+	size_t mCapacity;
+	size_t mOffset;
+	size_t mPeak;
+
+	// heap allocations made after the arena filled up (freed at the next reset)
+	std::vector<void*> mSpilled;
+	size_t mSpilledBytes;
+};
+
+// rewinds the calling thread's arena to where it was when the scope started
+// (for recursive code like game tree searches, which would otherwise fill the arena with dead temporaries)
+class FrameScope {
+public:
+	FrameScope() {
+		mMarker = FrameAllocator::Get().GetMarker();
+	}
+	~FrameScope() {
+		FrameAllocator::Get().FreeToMarker(mMarker);
+	}
+
+private:
+	FrameAllocator::Marker mMarker;
+};
+
+// STL allocator adaptor, allocating from the calling thread's arena
+template <typename T>
+class FrameStdAllocator {
+public:
+	typedef T value_type;
+
+	FrameStdAllocator() {}
+	template <typename U>
+	FrameStdAllocator(const FrameStdAllocator<U>& other) {}
+
+	T* allocate(size_t n) {
+		return static_cast<T*>(FrameAllocator::Get().Allocate(n * sizeof(T), alignof(T)));
+	}
+	void deallocate(T* ptr, size_t n) {
+		FrameAllocator::Get().Free(ptr, n * sizeof(T));
+	}
+
+	template <typename U>
+	bool operator==(const FrameStdAllocator<U>& other) const {
+		return true;
+	}
+	template <typename U>
+	bool operator!=(const FrameStdAllocator<U>& other) const {
+		return false;
+	}
+};
+
+// vector living in the frame arena
+template <typename T>
+using FrameVector = std::vector<T, FrameStdAllocator<T>>;
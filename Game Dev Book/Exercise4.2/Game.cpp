@@ -4,6 +4,7 @@
 #include "Actor.hpp"
 #include "SpriteComponent.hpp"
 #include "Random.hpp"
+#include "FrameAllocator.hpp"
 
 Game::Game() {
 	mWindow = nullptr;
@@ -46,6 +47,9 @@ bool Game::Initialize() {
 
 void Game::RunLoop() {
 	while (mIsRunning) {
+		// release last frame's scratch memory
+		FrameAllocator::ResetAll();
+
 		ProcessInput();
 		UpdateGame();
 		GenerateOutput();
@@ -118,7 +122,7 @@ void Game::UpdateGame() {
 	mPendingActors.clear();
 
 	// Add any dead actors to a temp vector
-	std::vector<Actor*> deadActors;
+	FrameVector<Actor*> deadActors;
 	for (auto actor : mActors) {
 		if (actor->GetState() == Actor::EDead) {
 			deadActors.emplace_back(actor);